@@ -0,0 +1,406 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+// Parse time of the FOM files (.fed and .xml) of a directory, by two
+// paths :
+//
+// - DOM : the whole document is loaded first (xmlParseFile for .xml, a
+//   tree of lists for .fed), then walked, as the bridge did before the
+//   reader and the native .fed parser ;
+// - reader : Federation, which reads the file in a single pass.
+//
+// Both paths must give the same trees of object classes with their
+// attributes, and of interaction classes with their parameters (names,
+// transportation, order and routing space) : the handles are resolved
+// from these names, so the same trees give the same handles. A .fed and a
+// .xml file of the same name must give the same trees as well, routing
+// spaces aside. XML files that are not FOMs (bridge configurations) are
+// skipped. Returns 1 if some trees differ.
+//
+// Build with -DBUILD_BENCH=ON, run bench_fom [directory] [parses]
+
+#include "Federation.hh"
+#include "XmlProp.hh"
+#include "Clock.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <map>
+#include <algorithm>
+
+using namespace std ;
+
+// List of a .fed file, or atom if it has no item
+struct FedNode
+{
+    string atom ;
+    vector<FedNode> items ;
+    bool list ;
+};
+
+// ---------------------------------------------------------------------------
+// Line : one class or member of a tree, indented by its depth
+// 
+template<typename E>
+static void
+Line(ostringstream &out, int depth, const char* kind, E &e, bool spaces)
+{
+    out << string(2 * depth, ' ') << kind << " " << e.getName() << " " 
+        << e.getTransport() << e.getOrder() ;
+    if (spaces) out << " [" << e.getSpace() << "]" ;
+    out << "\n" ;
+}
+
+// ---------------------------------------------------------------------------
+// Dump : text of a class tree parsed by Federation
+// 
+template<typename C>
+static void
+Dump(ostringstream &out, vector<C> &v, int depth, bool spaces)
+{
+    for (typename vector<C>::iterator c=v.begin(); c!=v.end(); c++) {
+        Line(out, depth, "class", *c, spaces);
+        for (size_t k = 0 ; k < c->getAttributes().size() ; k++)
+            Line(out, depth + 1, "member", c->getAttributes()[k], spaces);
+        Dump(out, c->getSubEntities(), depth + 1, spaces);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Reader : trees of a file, parsed by Federation
+// 
+static string
+Reader(const string &file, bool spaces)
+{
+    Federation f(NULL, file);
+    ostringstream out ;
+    out << "objects\n" ;
+    Dump(out, f.getObjectClasses(), 1, spaces);
+    out << "interactions\n" ;
+    Dump(out, f.getInteractionClasses(), 1, spaces);
+    return out.str();
+}
+
+// ---------------------------------------------------------------------------
+// Delivery : transportation, order and space of an XML element, as text
+// 
+static void
+Delivery(ostringstream &out, xmlNodePtr node, bool spaces)
+{
+    string t = GetXmlProp(node, "transportation");
+    string o = GetXmlProp(node, "order");
+    out << (t == "HLAbestEffort" ? TRANSPORT_BEST_EFFORT : TRANSPORT_RELIABLE)
+        << (o == "Receive" ? ORDER_RECEIVE : ORDER_TIMESTAMP) ;
+    if (spaces) out << " [" << GetXmlProp(node, "space") << "]" ;
+    out << "\n" ;
+}
+
+// ---------------------------------------------------------------------------
+// DumpXml : text of an objectClass or interactionClass element
+// 
+static void
+DumpXml(ostringstream &out, xmlNodePtr node, int depth, bool spaces)
+{
+    bool interaction = !xmlStrcmp(node->name, NODE_INTERACTION_CLASS);
+    out << string(2 * depth, ' ') << "class " << GetXmlProp(node, "name") 
+        << " " ;
+    if (interaction) Delivery(out, node, spaces);
+    else {
+        out << TRANSPORT_RELIABLE << ORDER_TIMESTAMP ;
+        if (spaces) out << " []" ;
+        out << "\n" ;
+    }
+    const xmlChar* member = interaction ? NODE_PARAMETER : NODE_ATTRIBUTE ;
+    for (xmlNodePtr c = node->children ; c ; c = c->next) {
+        if (xmlStrcmp(c->name, member)) continue ;
+        out << string(2 * depth + 2, ' ') << "member " 
+            << GetXmlProp(c, "name") << " " ;
+        if (interaction) {
+            out << TRANSPORT_RELIABLE << ORDER_TIMESTAMP ;
+            if (spaces) out << " []" ;
+            out << "\n" ;
+        }
+        else Delivery(out, c, spaces);
+    }
+    for (xmlNodePtr c = node->children ; c ; c = c->next) {
+        if (!xmlStrcmp(c->name, node->name)) 
+            DumpXml(out, c, depth + 1, spaces);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Dom : trees of a .xml file, loaded as a DOM. Sets fom to false if the
+// file is not a FOM.
+// 
+static string
+Dom(const string &file, bool spaces, bool &fom)
+{
+    ostringstream out ;
+    xmlDocPtr doc = xmlParseFile(file.c_str());
+    xmlNodePtr root = doc ? xmlDocGetRootElement(doc) : NULL ;
+    fom = root && !xmlStrcmp(root->name, NODE_OBJECT_MODEL) ;
+    if (fom) {
+        const xmlChar* group[] = { NODE_OBJECTS, NODE_INTERACTIONS };
+        const xmlChar* item[] = { NODE_OBJECT_CLASS, NODE_INTERACTION_CLASS };
+        for (int g = 0 ; g < 2 ; g++) {
+            out << (const char*) group[g] << "\n" ;
+            for (xmlNodePtr n = root->children ; n ; n = n->next) {
+                if (xmlStrcmp(n->name, group[g])) continue ;
+                for (xmlNodePtr c = n->children ; c ; c = c->next) {
+                    if (!xmlStrcmp(c->name, item[g])) 
+                        DumpXml(out, c, 1, spaces);
+                }
+            }
+        }
+    }
+    if (doc) xmlFreeDoc(doc);
+    return out.str();
+}
+
+// ---------------------------------------------------------------------------
+// ParseFed : lists of a .fed text, from position p
+// 
+static bool
+ParseFed(const string &text, size_t &p, FedNode &list)
+{
+    list.list = true ;
+    while (p < text.size()) {
+        char c = text[p] ;
+        if (c == ';') {
+            while (p < text.size() && text[p] != '\n') p++ ;
+        }
+        else if (isspace((unsigned char) c)) p++ ;
+        else if (c == '(') {
+            p++ ;
+            list.items.push_back(FedNode());
+            if (!ParseFed(text, p, list.items.back())) return false ;
+        }
+        else if (c == ')') {
+            p++ ;
+            return true ;
+        }
+        else {
+            FedNode a ;
+            a.list = false ;
+            if (c == '"') {
+                size_t q = text.find('"', p + 1);
+                if (q == string::npos) return false ;
+                a.atom = text.substr(p + 1, q - p - 1);
+                p = q + 1 ;
+            }
+            else {
+                size_t q = p ;
+                while (q < text.size() && !isspace((unsigned char) text[q]) &&
+                       !strchr("();\"", text[q])) q++ ;
+                a.atom = text.substr(p, q - p);
+                p = q ;
+            }
+            list.items.push_back(a);
+        }
+    }
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// Is : keyword of a list, compared without case
+// 
+static bool
+Is(const FedNode &n, const char* s)
+{
+    return n.list && !n.items.empty() && !n.items[0].list && 
+        !strcasecmp(n.items[0].atom.c_str(), s) ;
+}
+
+// ---------------------------------------------------------------------------
+// DumpFedMember : name and delivery atoms of an attribute, parameter or
+// interaction class list
+// 
+static void
+DumpFedMember(ostringstream &out, const FedNode &n, bool spaces)
+{
+    Transport t = TRANSPORT_RELIABLE ;
+    Order o = ORDER_TIMESTAMP ;
+    string space ;
+    for (size_t k = 2 ; k < n.items.size() ; k++) {
+        if (n.items[k].list) continue ;
+        const char* a = n.items[k].atom.c_str();
+        if (!strcasecmp(a, "reliable") || !strcasecmp(a, "FED_RELIABLE"))
+            t = TRANSPORT_RELIABLE ;
+        else if (!strcasecmp(a, "best_effort") || 
+                 !strcasecmp(a, "FED_BEST_EFFORT"))
+            t = TRANSPORT_BEST_EFFORT ;
+        else if (!strcasecmp(a, "timestamp") || 
+                 !strcasecmp(a, "FED_TIMESTAMP"))
+            o = ORDER_TIMESTAMP ;
+        else if (!strcasecmp(a, "receive") || !strcasecmp(a, "FED_RECEIVE"))
+            o = ORDER_RECEIVE ;
+        else space = a ;
+    }
+    out << n.items[1].atom << " " << t << o ;
+    if (spaces) out << " [" << space << "]" ;
+    out << "\n" ;
+}
+
+// ---------------------------------------------------------------------------
+// DumpFed : text of a (class ...) list
+// 
+static void
+DumpFed(ostringstream &out, const FedNode &n, int depth, bool interaction,
+        bool spaces)
+{
+    if (n.items.size() < 2 || n.items[1].list) return ;
+    out << string(2 * depth, ' ') << "class " ;
+    if (interaction) DumpFedMember(out, n, spaces);
+    else {
+        out << n.items[1].atom << " " << TRANSPORT_RELIABLE << ORDER_TIMESTAMP ;
+        if (spaces) out << " []" ;
+        out << "\n" ;
+    }
+    const char* member = interaction ? "parameter" : "attribute" ;
+    for (size_t k = 2 ; k < n.items.size() ; k++) {
+        const FedNode &c = n.items[k] ;
+        if (!Is(c, member) || c.items.size() < 2 || c.items[1].list) continue ;
+        out << string(2 * depth + 2, ' ') << "member " ;
+        if (interaction) {
+            out << c.items[1].atom << " " << TRANSPORT_RELIABLE 
+                << ORDER_TIMESTAMP ;
+            if (spaces) out << " []" ;
+            out << "\n" ;
+        }
+        else DumpFedMember(out, c, spaces);
+    }
+    for (size_t k = 2 ; k < n.items.size() ; k++) {
+        if (Is(n.items[k], "class")) 
+            DumpFed(out, n.items[k], depth + 1, interaction, spaces);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// DomFed : trees of a .fed file, loaded as a tree of lists
+// 
+static string
+DomFed(const string &file, bool spaces)
+{
+    ifstream in(file.c_str(), ios::in | ios::binary);
+    string text((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    FedNode top ;
+    size_t p = 0 ;
+    ostringstream out ;
+    if (!ParseFed(text, p, top)) return "" ;
+
+    const char* group[] = { "objects", "interactions" };
+    for (int g = 0 ; g < 2 ; g++) {
+        out << group[g] << "\n" ;
+        for (size_t i = 0 ; i < top.items.size() ; i++) {
+            if (!Is(top.items[i], "fed")) continue ;
+            const FedNode &fed = top.items[i] ;
+            for (size_t j = 1 ; j < fed.items.size() ; j++) {
+                if (!Is(fed.items[j], group[g])) continue ;
+                const FedNode &l = fed.items[j] ;
+                for (size_t k = 1 ; k < l.items.size() ; k++) {
+                    if (Is(l.items[k], "class"))
+                        DumpFed(out, l.items[k], 1, g == 1, spaces);
+                }
+            }
+        }
+    }
+    return out.str();
+}
+
+// ---------------------------------------------------------------------------
+// IsFed : true for a .fed file name
+// 
+static bool
+IsFed(const string &file)
+{
+    return file.size() > 4 && 
+        !strcasecmp(file.c_str() + file.size() - 4, ".fed") ;
+}
+
+// ---------------------------------------------------------------------------
+// main
+// 
+int
+main(int argc, char** argv)
+{
+    string directory = argc > 1 ? argv[1] : "." ;
+    int parses = argc > 2 ? atoi(argv[2]) : 200 ;
+    int failures = 0 ;
+
+    vector<string> files ;
+    DIR* d = opendir(directory.c_str());
+    if (d == NULL) {
+        cerr << "Cannot open directory " << directory << endl ;
+        return 1 ;
+    }
+    struct dirent* e ;
+    while ((e = readdir(d)) != NULL) {
+        string name = e->d_name ;
+        size_t n = name.size();
+        if (n > 4 && (IsFed(name) || 
+                      !strcasecmp(name.c_str() + n - 4, ".xml")))
+            files.push_back(directory + "/" + name);
+    }
+    closedir(d);
+    sort(files.begin(), files.end());
+
+    map<string, string> trees ; // by file name without extension
+    printf("%-32s %10s %10s %6s\n", "file", "DOM us", "reader us", "trees");
+    for (size_t i = 0 ; i < files.size() ; i++) {
+        const string &file = files[i] ;
+        bool fed = IsFed(file), fom = true ;
+        string dom = fed ? DomFed(file, true) : Dom(file, true, fom);
+        if (!fom) {
+            printf("%-32s %10s %10s %6s\n", file.c_str(), "-", "-", "no FOM");
+            continue ;
+        }
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (int k = 0 ; k < parses ; k++) {
+            if (fed) DomFed(file, true);
+            else Dom(file, true, fom);
+        }
+        double domTime = Since(start) / parses ;
+
+        start = chrono::steady_clock::now();
+        for (int k = 0 ; k < parses ; k++) Federation f(NULL, file);
+        double readerTime = Since(start) / parses ;
+
+        bool same = Reader(file, true) == dom ;
+        if (!same) failures++ ;
+        printf("%-32s %10.1f %10.1f %6s\n", file.c_str(), domTime * 1e6, 
+               readerTime * 1e6, same ? "same" : "DIFFER");
+
+        // Same trees for the .fed and .xml files of a federation
+        string stem = file.substr(0, file.size() - 4);
+        string tree = Reader(file, false);
+        map<string, string>::iterator t = trees.find(stem);
+        if (t == trees.end()) trees[stem] = tree ;
+        else if (t->second != tree) {
+            printf("%-32s %s.fed and %s.xml trees DIFFER\n", "", 
+                   stem.c_str(), stem.c_str());
+            failures++ ;
+        }
+    }
+    return failures ? 1 : 0 ;
+}
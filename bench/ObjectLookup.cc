@@ -0,0 +1,110 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+// Cost of the lookups of discovered objects through the index of
+// Federation (objectExists, getObjectTranslation) from 100 to 1M objects.
+//
+// The lookups are chained : the surrogate of each object is the handle of
+// the next one in a random cycle, so that every lookup waits for the
+// previous one and the time is the latency of a lookup. The same random
+// cycle is also followed through a plain array with one cache line per
+// object : this baseline is the cost of the cache misses alone, that any
+// structure holding that many objects pays. The index is flat when the
+// ratio between both stays the same for every size : a lookup then costs
+// a fixed number of memory accesses, whatever the number of objects.
+//
+// Build with -DBUILD_BENCH=ON, run bench_objects [fed file] [lookups] from
+// the data directory.
+
+#include "Federation.hh"
+#include "Clock.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <random>
+
+using namespace std ;
+
+#define BENCH_LINE 64
+
+struct Node
+{
+    size_t next ;
+    char pad[BENCH_LINE - sizeof(size_t)] ;
+};
+
+// ---------------------------------------------------------------------------
+// main
+// 
+int
+main(int argc, char** argv)
+{
+    string fedfile = argc > 1 ? argv[1] : "Test01.xml" ;
+    long lookups = argc > 2 ? atol(argv[2]) : 10000000 ;
+
+    printf("%10s %10s %10s %10s %10s %10s\n", "objects", "insert", 
+           "baseline", "hit", "hit/base", "miss");
+    for (long n = 100 ; n <= 1000000 ; n *= 10) {
+        Federation federation(NULL, fedfile);
+        Federation peer(NULL, fedfile);
+        federation.connect(peer);
+
+        // Handles as the RTI gives them, not contiguous, in a random cycle
+        vector<RTI::ObjectHandle> handles(n);
+        for (long i = 0 ; i < n ; i++) handles[i] = 1 + i * 7 ;
+        vector<size_t> cycle(n);
+        for (long i = 0 ; i < n ; i++) cycle[i] = i ;
+        shuffle(cycle.begin(), cycle.end(), mt19937(n));
+
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        for (long i = 0 ; i < n ; i++)
+            federation.discoverObject(handles[i], 1, "");
+        double insert = Since(start) / n ;
+
+        vector<Node> nodes(n);
+        for (long i = 0 ; i < n ; i++) {
+            size_t from = cycle[i], to = cycle[(i + 1) % n] ;
+            nodes[from].next = to ;
+            federation.setObjectTranslation(0, handles[from], handles[to]);
+        }
+
+        size_t k = cycle[0] ;
+        start = chrono::steady_clock::now();
+        for (long i = 0 ; i < lookups ; i++) k = nodes[k].next ;
+        double baseline = Since(start) / lookups ;
+
+        RTI::ObjectHandle h = handles[cycle[0]] ;
+        start = chrono::steady_clock::now();
+        for (long i = 0 ; i < lookups ; i++) 
+            h = federation.getObjectTranslation(0, h);
+        double hit = Since(start) / lookups ;
+
+        // Handles of the objects are multiples of 7 plus 1 : never found
+        long found = 0 ;
+        start = chrono::steady_clock::now();
+        for (long i = 0 ; i < lookups ; i++) 
+            found += federation.objectExists(handles[i % n] + 1 + (found & 1));
+        double miss = Since(start) / lookups ;
+
+        printf("%10ld %10.1f %10.1f %10.1f %10.1f %10.1f\n", n, insert * 1e9, 
+               baseline * 1e9, hit * 1e9, hit / baseline, miss * 1e9);
+        if (k == (size_t) -1 || h == 0 || found) printf("\n"); // keep the loops
+    }
+    return 0 ;
+}
@@ -0,0 +1,168 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "AllowList.hh"
+#include "Federation.hh"
+#include <iostream>
+
+// ---------------------------------------------------------------------------
+// AllowList
+// 
+AllowList::AllowList()
+{
+}
+
+// ---------------------------------------------------------------------------
+// ~AllowList
+// 
+AllowList::~AllowList()
+{
+}
+
+// ---------------------------------------------------------------------------
+// addClass : allow a class, with all its attributes unless some are added
+// 
+void
+AllowList::addClass(string c)
+{
+    for (size_t i = 0 ; i < specs.size() ; i++) {
+        if (specs[i].name == c) return ;
+    }
+    ClassSpec s ;
+    s.name = c ;
+    specs.push_back(s);
+}
+
+// ---------------------------------------------------------------------------
+// addAttribute : allow an attribute of a class (or of its parents)
+// 
+void
+AllowList::addAttribute(string c, string a)
+{
+    this->addClass(c);
+    for (size_t i = 0 ; i < specs.size() ; i++) {
+        if (specs[i].name == c) specs[i].attributes.push_back(a);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// addInteraction
+// 
+void
+AllowList::addInteraction(string i)
+{
+    interactionNames.push_back(i);
+}
+
+// ---------------------------------------------------------------------------
+// compile : resolve the names into bitsets, once the federation joined.
+// Unknown names are reported and ignored.
+// 
+void
+AllowList::compile(Federation &f)
+{
+    classes.clear();
+    wholeClasses.clear();
+    attributes.clear();
+    interactions.clear();
+
+    for (vector<ClassSpec>::iterator i = specs.begin() ; i != specs.end() ; i++) {
+        RTI::ObjectClassHandle c = f.getObjectClassHandle(i->name);
+        if (c == 0) {
+            cout << "Warning: allow list of unknown class " << i->name << endl ;
+            continue ;
+        }
+        if (c >= classes.size()) {
+            classes.resize(c + 1, false);
+            wholeClasses.resize(c + 1, false);
+            attributes.resize(c + 1);
+        }
+        classes[c] = true ;
+        if (i->attributes.empty()) wholeClasses[c] = true ;
+        for (vector<string>::iterator j = i->attributes.begin() ; 
+             j != i->attributes.end() ; j++) {
+            RTI::AttributeHandle a = f.getAttributeHandle(i->name, *j);
+            if (a == 0) {
+                cout << "Warning: allow list of unknown attribute " 
+                     << i->name << "." << *j << endl ;
+                continue ;
+            }
+            if (a >= attributes[c].size()) attributes[c].resize(a + 1, false);
+            attributes[c][a] = true ;
+        }
+    }
+
+    for (vector<string>::iterator i = interactionNames.begin() ; 
+         i != interactionNames.end() ; i++) {
+        RTI::InteractionClassHandle h = f.getInteractionClassHandle(*i);
+        if (h == 0) {
+            cout << "Warning: allow list of unknown interaction " << *i << endl ;
+            continue ;
+        }
+        if (h >= interactions.size()) interactions.resize(h + 1, false);
+        interactions[h] = true ;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// restrictsClasses : true if some class is listed
+// 
+bool
+AllowList::restrictsClasses(void)
+{
+    return !specs.empty();
+}
+
+// ---------------------------------------------------------------------------
+// restrictsInteractions : true if some interaction is listed
+// 
+bool
+AllowList::restrictsInteractions(void)
+{
+    return !interactionNames.empty();
+}
+
+// ---------------------------------------------------------------------------
+// allowsClass
+// 
+bool
+AllowList::allowsClass(RTI::ObjectClassHandle c)
+{
+    if (specs.empty()) return true ;
+    return c < classes.size() && classes[c] ;
+}
+
+// ---------------------------------------------------------------------------
+// allowsAttribute
+// 
+bool
+AllowList::allowsAttribute(RTI::ObjectClassHandle c, RTI::AttributeHandle a)
+{
+    if (specs.empty()) return true ;
+    if (c >= classes.size() || !classes[c]) return false ;
+    if (wholeClasses[c]) return true ;
+    return a < attributes[c].size() && attributes[c][a] ;
+}
+
+// ---------------------------------------------------------------------------
+// allowsInteraction
+// 
+bool
+AllowList::allowsInteraction(RTI::InteractionClassHandle i)
+{
+    if (interactionNames.empty()) return true ;
+    return i < interactions.size() && interactions[i] ;
+}
@@ -0,0 +1,68 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef ALLOW_LIST_HH
+#define ALLOW_LIST_HH
+
+#include <config.h>
+#include <string>
+#include <vector>
+#include <RTI.hh>
+
+class Federation ;
+
+using namespace std ;
+
+// Object classes, attributes and interactions a federation exchanges in one
+// direction (publication or subscription). Names given by the configuration
+// are compiled into bitsets indexed by handle. A class given without
+// attributes allows all of its attributes. A list without classes allows
+// every class, a list without interactions every interaction.
+class AllowList
+{
+public:
+    AllowList();
+    ~AllowList();
+
+    void addClass(string);
+    void addAttribute(string, string);
+    void addInteraction(string);
+
+    void compile(Federation&);
+    bool restrictsClasses(void);
+    bool restrictsInteractions(void);
+
+    bool allowsClass(RTI::ObjectClassHandle);
+    bool allowsAttribute(RTI::ObjectClassHandle, RTI::AttributeHandle);
+    bool allowsInteraction(RTI::InteractionClassHandle);
+
+private:
+    struct ClassSpec {
+        string name ;
+        vector<string> attributes ; // empty : all
+    };
+
+    vector<ClassSpec> specs ;
+    vector<string> interactionNames ;
+
+    // Compiled, by class handle
+    vector<bool> classes ;
+    vector<bool> wholeClasses ;
+    vector<vector<bool> > attributes ;
+    vector<bool> interactions ;
+};
+
+#endif // ALLOW_LIST_HH
@@ -0,0 +1,201 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef CANONICAL_MAP_HH
+#define CANONICAL_MAP_HH
+
+#include <cstddef>
+#include <vector>
+#include "CanonicalModel.hh"
+
+using namespace std ;
+
+// Translations of one federation to and from the canonical model. To the
+// model, tables are indexed by local class handle, then by local member
+// (attribute or parameter) handle. From the model, tables are indexed by
+// canonical identifier. 0 means "no translation".
+template<typename C, typename M>
+class CanonicalMap {
+
+    // Attributes
+protected:
+    vector<CanonicalId> classes ;
+    vector<vector<CanonicalId> > members ;
+    vector<CanonicalId> layouts ;
+    vector<C> localClasses ;
+    vector<M> localMembers ;
+
+    // Methods
+public:
+    CanonicalMap();
+    ~CanonicalMap();
+
+    void clear(void);
+
+    void setClass(C, CanonicalId);
+    CanonicalId getClass(C);
+    void setMember(C, M, CanonicalId);
+    CanonicalId getMember(C, M);
+    const vector<CanonicalId>* getMembers(C);
+    void setLayout(C, CanonicalId);
+    CanonicalId getLayout(C);
+
+    void setLocalClass(CanonicalId, C);
+    C getLocalClass(CanonicalId);
+    CanonicalId getLocalClassCount(void);
+    void setLocalMember(CanonicalId, M);
+    M getLocalMember(CanonicalId);
+    CanonicalId getLocalMemberCount(void);
+
+private:
+    void grow(C);
+};
+
+// --------------------------------------------------------------------------
+
+template<typename C, typename M>
+CanonicalMap<C, M>::CanonicalMap()
+{
+}
+
+template<typename C, typename M>
+CanonicalMap<C, M>::~CanonicalMap()
+{
+}
+
+template<typename C, typename M>
+void
+CanonicalMap<C, M>::clear(void)
+{
+    classes.clear();
+    members.clear();
+    layouts.clear();
+    localClasses.clear();
+    localMembers.clear();
+}
+
+template<typename C, typename M>
+void
+CanonicalMap<C, M>::grow(C c)
+{
+    if (c >= classes.size()) {
+        classes.resize(c + 1, 0);
+        members.resize(c + 1);
+        layouts.resize(c + 1, 0);
+    }
+}
+
+template<typename C, typename M>
+void
+CanonicalMap<C, M>::setClass(C c, CanonicalId id)
+{
+    this->grow(c);
+    classes[c] = id ;
+}
+
+template<typename C, typename M>
+CanonicalId
+CanonicalMap<C, M>::getClass(C c)
+{
+    return c < classes.size() ? classes[c] : 0 ;
+}
+
+template<typename C, typename M>
+void
+CanonicalMap<C, M>::setMember(C c, M m, CanonicalId id)
+{
+    this->grow(c);
+    if (m >= members[c].size()) members[c].resize(m + 1, 0);
+    members[c][m] = id ;
+}
+
+template<typename C, typename M>
+CanonicalId
+CanonicalMap<C, M>::getMember(C c, M m)
+{
+    if (c >= members.size() || m >= members[c].size()) return 0 ;
+    return members[c][m] ;
+}
+
+template<typename C, typename M>
+const vector<CanonicalId>*
+CanonicalMap<C, M>::getMembers(C c)
+{
+    return c < members.size() ? &members[c] : NULL ;
+}
+
+template<typename C, typename M>
+void
+CanonicalMap<C, M>::setLayout(C c, CanonicalId id)
+{
+    this->grow(c);
+    layouts[c] = id ;
+}
+
+template<typename C, typename M>
+CanonicalId
+CanonicalMap<C, M>::getLayout(C c)
+{
+    return c < layouts.size() ? layouts[c] : 0 ;
+}
+
+template<typename C, typename M>
+void
+CanonicalMap<C, M>::setLocalClass(CanonicalId id, C c)
+{
+    if (id >= localClasses.size()) localClasses.resize(id + 1, 0);
+    localClasses[id] = c ;
+}
+
+template<typename C, typename M>
+C
+CanonicalMap<C, M>::getLocalClass(CanonicalId id)
+{
+    return id < localClasses.size() ? localClasses[id] : 0 ;
+}
+
+// Highest canonical class resolved
+template<typename C, typename M>
+CanonicalId
+CanonicalMap<C, M>::getLocalClassCount(void)
+{
+    return localClasses.empty() ? 0 : localClasses.size() - 1 ;
+}
+
+template<typename C, typename M>
+void
+CanonicalMap<C, M>::setLocalMember(CanonicalId id, M m)
+{
+    if (id >= localMembers.size()) localMembers.resize(id + 1, 0);
+    localMembers[id] = m ;
+}
+
+template<typename C, typename M>
+M
+CanonicalMap<C, M>::getLocalMember(CanonicalId id)
+{
+    return id < localMembers.size() ? localMembers[id] : 0 ;
+}
+
+// Highest canonical member resolved
+template<typename C, typename M>
+CanonicalId
+CanonicalMap<C, M>::getLocalMemberCount(void)
+{
+    return localMembers.empty() ? 0 : localMembers.size() - 1 ;
+}
+
+#endif // CANONICAL_MAP_HH
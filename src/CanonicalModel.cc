@@ -0,0 +1,179 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "CanonicalModel.hh"
+
+// ---------------------------------------------------------------------------
+// CanonicalModel
+// 
+CanonicalModel::CanonicalModel()
+{
+}
+
+// ---------------------------------------------------------------------------
+// ~CanonicalModel
+// 
+CanonicalModel::~CanonicalModel()
+{
+}
+
+// ---------------------------------------------------------------------------
+// Names::get : identifier of a name, created if new
+// 
+CanonicalId
+CanonicalModel::Names::get(const string &owner, const string &name)
+{
+    // '.' cannot appear in a FOM name
+    string key = owner.empty() ? name : owner + "." + name ;
+    unordered_map<string, CanonicalId>::iterator i = ids.find(key);
+    if (i != ids.end()) return i->second ;
+    owners.push_back(owner);
+    names.push_back(name);
+    CanonicalId id = names.size();
+    ids[key] = id ;
+    return id ;
+}
+
+// ---------------------------------------------------------------------------
+// getObjectClass
+// 
+CanonicalId
+CanonicalModel::getObjectClass(const string &name)
+{
+    lock_guard<mutex> guard(lock);
+    return objectClasses.get("", name);
+}
+
+// ---------------------------------------------------------------------------
+// getAttribute : attribute of a given name, declared by a given class
+// 
+CanonicalId
+CanonicalModel::getAttribute(const string &owner, const string &name)
+{
+    lock_guard<mutex> guard(lock);
+    return attributes.get(owner, name);
+}
+
+// ---------------------------------------------------------------------------
+// getInteractionClass
+// 
+CanonicalId
+CanonicalModel::getInteractionClass(const string &name)
+{
+    lock_guard<mutex> guard(lock);
+    return interactionClasses.get("", name);
+}
+
+// ---------------------------------------------------------------------------
+// getParameter : parameter of a given name, declared by a given class
+// 
+CanonicalId
+CanonicalModel::getParameter(const string &owner, const string &name)
+{
+    lock_guard<mutex> guard(lock);
+    return parameters.get(owner, name);
+}
+
+// ---------------------------------------------------------------------------
+// getLayout : identifier of the canonical members of a class, indexed by
+// local member handle
+// 
+CanonicalId
+CanonicalModel::getLayout(const vector<CanonicalId> &members)
+{
+    lock_guard<mutex> guard(lock);
+    map<vector<CanonicalId>, CanonicalId>::iterator i = layouts.find(members);
+    if (i != layouts.end()) return i->second ;
+    CanonicalId id = layouts.size() + 1 ;
+    layouts[members] = id ;
+    return id ;
+}
+
+// ---------------------------------------------------------------------------
+// get...Count : highest identifier
+// 
+CanonicalId
+CanonicalModel::getObjectClassCount(void)
+{
+    lock_guard<mutex> guard(lock);
+    return objectClasses.names.size();
+}
+
+CanonicalId
+CanonicalModel::getAttributeCount(void)
+{
+    lock_guard<mutex> guard(lock);
+    return attributes.names.size();
+}
+
+CanonicalId
+CanonicalModel::getInteractionClassCount(void)
+{
+    lock_guard<mutex> guard(lock);
+    return interactionClasses.names.size();
+}
+
+CanonicalId
+CanonicalModel::getParameterCount(void)
+{
+    lock_guard<mutex> guard(lock);
+    return parameters.names.size();
+}
+
+// ---------------------------------------------------------------------------
+// get...Name, get...Owner : names of an identifier
+// 
+string
+CanonicalModel::getObjectClassName(CanonicalId id)
+{
+    lock_guard<mutex> guard(lock);
+    return objectClasses.names[id - 1] ;
+}
+
+string
+CanonicalModel::getAttributeOwner(CanonicalId id)
+{
+    lock_guard<mutex> guard(lock);
+    return attributes.owners[id - 1] ;
+}
+
+string
+CanonicalModel::getAttributeName(CanonicalId id)
+{
+    lock_guard<mutex> guard(lock);
+    return attributes.names[id - 1] ;
+}
+
+string
+CanonicalModel::getInteractionClassName(CanonicalId id)
+{
+    lock_guard<mutex> guard(lock);
+    return interactionClasses.names[id - 1] ;
+}
+
+string
+CanonicalModel::getParameterOwner(CanonicalId id)
+{
+    lock_guard<mutex> guard(lock);
+    return parameters.owners[id - 1] ;
+}
+
+string
+CanonicalModel::getParameterName(CanonicalId id)
+{
+    lock_guard<mutex> guard(lock);
+    return parameters.names[id - 1] ;
+}
@@ -0,0 +1,85 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef CANONICAL_MODEL_HH
+#define CANONICAL_MODEL_HH
+
+#include <config.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <mutex>
+
+using namespace std ;
+
+// Bridge-wide identifier of a class, member (attribute or parameter) or
+// member layout ; 0 means none
+typedef unsigned long CanonicalId ;
+
+// Identifier space shared by all the federations of the bridge. Each
+// federation maps its handles to and from it, so that translations cost
+// one table per federation instead of one per pair of federations.
+// Classes are identified by name, members by the name of their declaring
+// class and their own name. A layout identifies the canonical members of
+// a class, by local member handle : two classes of the same layout
+// translate their members to the same handles.
+// Federations may join (and be given identifiers) while others read the
+// model : every access is locked, names are returned by value.
+class CanonicalModel
+{
+public:
+    CanonicalModel();
+    ~CanonicalModel();
+
+    CanonicalId getObjectClass(const string&);
+    CanonicalId getAttribute(const string&, const string&);
+    CanonicalId getInteractionClass(const string&);
+    CanonicalId getParameter(const string&, const string&);
+    CanonicalId getLayout(const vector<CanonicalId>&);
+
+    CanonicalId getObjectClassCount(void);
+    CanonicalId getAttributeCount(void);
+    CanonicalId getInteractionClassCount(void);
+    CanonicalId getParameterCount(void);
+
+    string getObjectClassName(CanonicalId);
+    string getAttributeOwner(CanonicalId);
+    string getAttributeName(CanonicalId);
+    string getInteractionClassName(CanonicalId);
+    string getParameterOwner(CanonicalId);
+    string getParameterName(CanonicalId);
+
+private:
+    // Interned (owner, name) pairs, owner empty for classes
+    class Names {
+    public:
+        CanonicalId get(const string&, const string&);
+        vector<string> owners ; // by id - 1
+        vector<string> names ;
+    private:
+        unordered_map<string, CanonicalId> ids ;
+    };
+
+    Names objectClasses ;
+    Names attributes ;
+    Names interactionClasses ;
+    Names parameters ;
+    map<vector<CanonicalId>, CanonicalId> layouts ;
+    mutex lock ;
+};
+
+#endif // CANONICAL_MODEL_HH
@@ -0,0 +1,150 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef CHANNEL_HH
+#define CHANNEL_HH
+
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+
+using namespace std ;
+
+#define CHANNEL_LINE 64
+
+// Bounded single-producer/single-consumer queue. Elements are preallocated
+// and reused : the producer fills the slot returned by reserve() then
+// publishes it with commit(), the consumer reads front() then releases it
+// with pop(). Neither side ever blocks nor allocates. Head and tail each
+// own a cache line ; channels are allocated on a line boundary so that the
+// alignment holds on the heap too.
+template<typename T>
+class Channel {
+
+    // Attributes
+protected:
+    vector<T> ring ;
+    size_t mask ;
+
+    alignas(CHANNEL_LINE) atomic<size_t> head ; // next slot to read, consumer
+    alignas(CHANNEL_LINE) atomic<size_t> tail ; // next slot to write, producer
+
+    // Methods
+public:
+    Channel(size_t);
+    ~Channel();
+
+    static void* operator new(size_t);
+    static void operator delete(void*);
+
+    T* reserve(void);
+    void commit(void);
+
+    T* front(void);
+    void pop(void);
+
+    bool empty(void);
+    size_t capacity(void);
+};
+
+// --------------------------------------------------------------------------
+
+template<typename T>
+Channel<T>::Channel(size_t n)
+{
+    size_t c = 1 ;
+    while (c < n) c *= 2 ;
+    ring.resize(c);
+    mask = c - 1 ;
+    head.store(0);
+    tail.store(0);
+}
+
+template<typename T>
+Channel<T>::~Channel()
+{
+}
+
+// operator new does not honour alignas before C++17
+template<typename T>
+void*
+Channel<T>::operator new(size_t n)
+{
+    void* p = NULL ;
+    if (posix_memalign(&p, CHANNEL_LINE, n)) throw bad_alloc();
+    return p ;
+}
+
+template<typename T>
+void
+Channel<T>::operator delete(void* p)
+{
+    free(p);
+}
+
+// Producer : free slot to fill, NULL if the channel is full
+template<typename T>
+T*
+Channel<T>::reserve(void)
+{
+    size_t t = tail.load(memory_order_relaxed);
+    if (t - head.load(memory_order_acquire) > mask) return NULL ;
+    return &ring[t & mask] ;
+}
+
+// Producer : publish the slot returned by reserve()
+template<typename T>
+void
+Channel<T>::commit(void)
+{
+    tail.store(tail.load(memory_order_relaxed) + 1, memory_order_release);
+}
+
+// Consumer : oldest published slot, NULL if the channel is empty
+template<typename T>
+T*
+Channel<T>::front(void)
+{
+    size_t h = head.load(memory_order_relaxed);
+    if (h == tail.load(memory_order_acquire)) return NULL ;
+    return &ring[h & mask] ;
+}
+
+// Consumer : release the slot returned by front()
+template<typename T>
+void
+Channel<T>::pop(void)
+{
+    head.store(head.load(memory_order_relaxed) + 1, memory_order_release);
+}
+
+template<typename T>
+bool
+Channel<T>::empty(void)
+{
+    return head.load(memory_order_acquire) == tail.load(memory_order_acquire);
+}
+
+template<typename T>
+size_t
+Channel<T>::capacity(void)
+{
+    return mask + 1 ;
+}
+
+#endif // CHANNEL_HH
@@ -0,0 +1,34 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+
+#ifndef CLOCK_HH
+#define CLOCK_HH
+
+#include <chrono>
+
+using namespace std ;
+
+// ---------------------------------------------------------------------------
+// Since : seconds elapsed since a point of the monotonic clock
+// 
+inline double
+Since(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+#endif // CLOCK_HH
@@ -0,0 +1,165 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "Coalescer.hh"
+
+// ---------------------------------------------------------------------------
+// Entry::reset
+// 
+void
+Coalescer::Entry::reset(RTI::ObjectHandle o, double t)
+{
+    object = o ;
+    first = t ;
+    time = t ;
+    handles.clear();
+    values.clear();
+}
+
+// ---------------------------------------------------------------------------
+// Entry::merge : last writer wins
+// 
+void
+Coalescer::Entry::merge(const RTI::AttributeHandleValuePairSet &attributes,
+                        double t)
+{
+    if (handles.empty()) first = t ;
+    time = t ;
+
+    RTI::ULong n = attributes.size();
+    for (RTI::ULong k = 0 ; k < n ; k++) {
+        RTI::AttributeHandle h = attributes.getHandle(k);
+        RTI::ULong length ;
+        const char* value = attributes.getValuePointer(k, length);
+
+        size_t j = 0 ;
+        while (j < handles.size() && handles[j] != h) j++ ;
+        if (j == handles.size()) {
+            handles.push_back(h);
+            values.resize(j + 1);
+        }
+        values[j].assign(value, length);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Entry::fill : copy the merged values into an attribute set
+// 
+void
+Coalescer::Entry::fill(RTI::AttributeHandleValuePairSet &set)
+{
+    set.empty();
+    for (size_t j = 0 ; j < handles.size() ; j++) {
+        set.add(handles[j], values[j].data(), values[j].size());
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Entry::empty
+// 
+bool
+Coalescer::Entry::empty(void)
+{
+    return handles.empty();
+}
+
+// ---------------------------------------------------------------------------
+// Coalescer
+// 
+Coalescer::Coalescer()
+{
+    window = 0.0 ;
+    count = 0 ;
+    merged = 0 ;
+}
+
+// ---------------------------------------------------------------------------
+// ~Coalescer
+// 
+Coalescer::~Coalescer()
+{
+}
+
+// ---------------------------------------------------------------------------
+// setWindow : 0 (or less) disables coalescing
+// 
+void
+Coalescer::setWindow(double w)
+{
+    window = w ;
+}
+
+// ---------------------------------------------------------------------------
+// getWindow
+// 
+double
+Coalescer::getWindow(void)
+{
+    return window ;
+}
+
+// ---------------------------------------------------------------------------
+// enabled
+// 
+bool
+Coalescer::enabled(void)
+{
+    return window > 0.0 ;
+}
+
+// ---------------------------------------------------------------------------
+// get : pending entry of an object, created empty if needed
+// 
+Coalescer::Entry*
+Coalescer::get(RTI::ObjectHandle object, double t)
+{
+    unordered_map<RTI::ObjectHandle, int>::iterator i = index.find(object);
+    if (i != index.end()) return &entries[i->second] ;
+
+    if (count == (int) entries.size()) entries.resize(count + 1);
+    Entry* e = &entries[count] ;
+    e->reset(object, t);
+    index[object] = count++ ;
+    return e ;
+}
+
+// ---------------------------------------------------------------------------
+// at : i-th pending entry
+// 
+Coalescer::Entry*
+Coalescer::at(int i)
+{
+    return &entries[i] ;
+}
+
+// ---------------------------------------------------------------------------
+// size : number of pending entries
+// 
+int
+Coalescer::size(void)
+{
+    return count ;
+}
+
+// ---------------------------------------------------------------------------
+// clear : drop every entry, keeping their buffers for reuse
+// 
+void
+Coalescer::clear(void)
+{
+    index.clear();
+    count = 0 ;
+}
@@ -0,0 +1,70 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef COALESCER_HH
+#define COALESCER_HH
+
+#include <config.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <RTI.hh>
+
+using namespace std ;
+
+// Pending updates of surrogate objects, merged attribute by attribute
+// (last writer wins) until they are flushed. An entry only merges updates
+// whose timestamps fall within the window of its first update ; it
+// carries the latest timestamp.
+class Coalescer
+{
+public:
+    class Entry {
+    public:
+        void reset(RTI::ObjectHandle, double);
+        void merge(const RTI::AttributeHandleValuePairSet&, double);
+        void fill(RTI::AttributeHandleValuePairSet&);
+        bool empty(void);
+
+        RTI::ObjectHandle object ;
+        double first ; // timestamp of the first merged update
+        double time ;  // timestamp of the last merged update
+        vector<RTI::AttributeHandle> handles ;
+        vector<string> values ;
+    };
+
+    Coalescer();
+    ~Coalescer();
+
+    void setWindow(double);
+    double getWindow(void);
+    bool enabled(void);
+
+    Entry* get(RTI::ObjectHandle, double);
+    Entry* at(int);
+    int size(void);
+    void clear(void);
+
+    unsigned long merged ; // updates absorbed by an earlier one
+
+private:
+    double window ;
+    unordered_map<RTI::ObjectHandle, int> index ;
+    vector<Entry> entries ; // entries beyond count are spare
+    int count ;
+};
+
+#endif // COALESCER_HH
@@ -0,0 +1,293 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "DeadReckoning.hh"
+#include "Federation.hh"
+#include <iostream>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+
+// ---------------------------------------------------------------------------
+// Swap : reverse the bytes of a big endian value on little endian hosts
+// 
+static void
+Swap(char* b, int n)
+{
+    const unsigned short one = 1 ;
+    if (*(const char*) &one == 0) return ; // big endian host
+    for (int i = 0 ; i < n / 2 ; i++) {
+        char c = b[i] ;
+        b[i] = b[n - 1 - i] ;
+        b[n - 1 - i] = c ;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// DeadReckoning
+// 
+DeadReckoning::DeadReckoning()
+{
+    suppressed = 0 ;
+    out = RTI::AttributeSetFactory::create(8);
+}
+
+// ---------------------------------------------------------------------------
+// ~DeadReckoning
+// 
+DeadReckoning::~DeadReckoning()
+{
+    delete out ;
+}
+
+// ---------------------------------------------------------------------------
+// addClass : heartbeat in seconds of logical time, 0 for none
+// 
+void
+DeadReckoning::addClass(string name, double heartbeat)
+{
+    ClassSpec c ;
+    c.name = name ;
+    c.handle = 0 ;
+    c.heartbeat = heartbeat ;
+    specs.push_back(c);
+}
+
+// ---------------------------------------------------------------------------
+// addAttribute : attribute of a class given to addClass
+// 
+void
+DeadReckoning::addAttribute(string className, string name, Encoding e,
+                            double threshold)
+{
+    for (vector<ClassSpec>::iterator i=specs.begin(); i!=specs.end(); i++) {
+        if (i->name == className) {
+            AttrSpec a ;
+            a.name = name ;
+            a.handle = 0 ;
+            a.encoding = e ;
+            a.threshold = threshold ;
+            i->attributes.push_back(a);
+            return ;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// parseEncoding : double, double-be, float, float-be or string
+// 
+bool
+DeadReckoning::parseEncoding(string s, Encoding &e)
+{
+    if (s == "double") e = DOUBLE ;
+    else if (s == "double-be") e = DOUBLE_BE ;
+    else if (s == "float") e = FLOAT ;
+    else if (s == "float-be") e = FLOAT_BE ;
+    else if (s == "string") e = STRING ;
+    else return false ;
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// compile : resolve class and attribute names, once the federation joined.
+// Unknown names are reported and ignored.
+// 
+void
+DeadReckoning::compile(Federation &f)
+{
+    vector<ClassSpec>::iterator i = specs.begin();
+    while (i != specs.end()) {
+        i->handle = f.getObjectClassHandle(i->name);
+        if (i->handle == 0) {
+            cout << "Warning: dead reckoning of unknown class " << i->name 
+                 << endl ;
+            i = specs.erase(i);
+            continue ;
+        }
+        vector<AttrSpec>::iterator j = i->attributes.begin();
+        while (j != i->attributes.end()) {
+            j->handle = f.getAttributeHandle(i->name, j->name);
+            if (j->handle == 0) {
+                cout << "Warning: dead reckoning of unknown attribute " 
+                     << i->name << "." << j->name << endl ;
+                j = i->attributes.erase(j);
+            }
+            else j++ ;
+        }
+        i++ ;
+    }
+    states.clear();
+}
+
+// ---------------------------------------------------------------------------
+// enabled
+// 
+bool
+DeadReckoning::enabled(void)
+{
+    return !specs.empty();
+}
+
+// ---------------------------------------------------------------------------
+// findClass : index of the spec of a class, -1 if none
+// 
+int
+DeadReckoning::findClass(RTI::ObjectClassHandle h)
+{
+    for (size_t i = 0 ; i < specs.size() ; i++) {
+        if (specs[i].handle == h) return i ;
+    }
+    return -1 ;
+}
+
+// ---------------------------------------------------------------------------
+// decode : numeric value of an attribute, false if it cannot be decoded
+// 
+bool
+DeadReckoning::decode(Encoding encoding, const char* value, 
+                      RTI::ULong length, double &x)
+{
+    char b[64] ;
+    switch (encoding) {
+      case DOUBLE:
+      case DOUBLE_BE: {
+          if (length != sizeof(double)) return false ;
+          double d ;
+          memcpy(b, value, sizeof(double));
+          if (encoding == DOUBLE_BE) Swap(b, sizeof(double));
+          memcpy(&d, b, sizeof(double));
+          x = d ;
+          break ;
+      }
+      case FLOAT:
+      case FLOAT_BE: {
+          if (length != sizeof(float)) return false ;
+          float d ;
+          memcpy(b, value, sizeof(float));
+          if (encoding == FLOAT_BE) Swap(b, sizeof(float));
+          memcpy(&d, b, sizeof(float));
+          x = d ;
+          break ;
+      }
+      case STRING: {
+          if (length == 0 || length >= sizeof(b)) return false ;
+          memcpy(b, value, length);
+          b[length] = '\0' ;
+          char* end ;
+          x = strtod(b, &end);
+          if (end == b) return false ;
+          break ;
+      }
+    }
+    return !isnan(x) ;
+}
+
+// ---------------------------------------------------------------------------
+// filter : attributes of an update to forward. The whole update is
+// forwarded when one of the extrapolated attributes is off by more than its
+// threshold (so that the state of the object stays consistent), otherwise
+// only the attributes without dead reckoning are.
+// 
+const RTI::AttributeHandleValuePairSet&
+DeadReckoning::filter(RTI::ObjectHandle object, RTI::ObjectClassHandle c,
+                      const RTI::AttributeHandleValuePairSet &in, double time)
+{
+    int s = this->findClass(c);
+    if (s < 0) return in ;
+    ClassSpec &spec = specs[s] ;
+
+    bool force = false ;
+    unordered_map<RTI::ObjectHandle, ObjectState>::iterator i = 
+        states.find(object);
+    if (i == states.end() || i->second.spec != s) {
+        ObjectState o ;
+        o.spec = s ;
+        o.last = time ;
+        AttrState a = { false, 0.0, 0.0, 0.0 } ;
+        o.attributes.assign(spec.attributes.size(), a);
+        i = states.insert(make_pair(object, o)).first ;
+        force = true ;
+    }
+    ObjectState &state = i->second ;
+    if (spec.heartbeat > 0.0 && time - state.last >= spec.heartbeat) {
+        force = true ;
+    }
+
+    RTI::ULong n = in.size();
+    values.resize(n);
+    positions.resize(n);
+    int dropped = 0 ;
+    for (RTI::ULong k = 0 ; k < n ; k++) {
+        RTI::AttributeHandle h = in.getHandle(k);
+        int j = spec.attributes.size() - 1 ;
+        while (j >= 0 && spec.attributes[j].handle != h) j-- ;
+        positions[k] = j ;
+        if (j < 0) continue ;
+        dropped++ ;
+
+        RTI::ULong length ;
+        const char* value = in.getValuePointer(k, length);
+        if (!decode(spec.attributes[j].encoding, value, length, values[k])) {
+            force = true ;
+            positions[k] = -1 ; // forwarded as is, state unchanged
+            continue ;
+        }
+        AttrState &a = state.attributes[j] ;
+        if (!a.valid) {
+            force = true ;
+            continue ;
+        }
+        double predicted = a.value + a.rate * (time - a.time) ;
+        if (fabs(values[k] - predicted) > spec.attributes[j].threshold) {
+            force = true ;
+        }
+    }
+
+    if (force) {
+        for (RTI::ULong k = 0 ; k < n ; k++) {
+            if (positions[k] < 0) continue ;
+            AttrState &a = state.attributes[positions[k]] ;
+            if (a.valid && time > a.time) {
+                a.rate = (values[k] - a.value) / (time - a.time) ;
+            }
+            else if (!a.valid) a.rate = 0.0 ;
+            a.value = values[k] ;
+            a.time = time ;
+            a.valid = true ;
+        }
+        state.last = time ;
+        return in ;
+    }
+
+    out->empty();
+    for (RTI::ULong k = 0 ; k < n ; k++) {
+        if (positions[k] >= 0) continue ;
+        RTI::ULong length ;
+        const char* value = in.getValuePointer(k, length);
+        out->add(in.getHandle(k), value, length);
+    }
+    suppressed += dropped ;
+    return *out ;
+}
+
+// ---------------------------------------------------------------------------
+// erase : forget an object
+// 
+void
+DeadReckoning::erase(RTI::ObjectHandle object)
+{
+    states.erase(object);
+}
@@ -0,0 +1,93 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef DEAD_RECKONING_HH
+#define DEAD_RECKONING_HH
+
+#include <config.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <RTI.hh>
+
+class Federation ;
+
+using namespace std ;
+
+// Dead reckoning filter for the updates reflected by a federation. For each
+// configured class, numeric attributes are extrapolated (first order) from
+// the last forwarded values ; they are forwarded only when the error of the
+// extrapolation exceeds their threshold, or when the heartbeat of the class
+// expires.
+class DeadReckoning
+{
+public:
+    enum Encoding { DOUBLE, DOUBLE_BE, FLOAT, FLOAT_BE, STRING };
+
+    DeadReckoning();
+    ~DeadReckoning();
+
+    void addClass(string, double);
+    void addAttribute(string, string, Encoding, double);
+    static bool parseEncoding(string, Encoding&);
+    static bool decode(Encoding, const char*, RTI::ULong, double&);
+
+    void compile(Federation&);
+    bool enabled(void);
+
+    const RTI::AttributeHandleValuePairSet& 
+    filter(RTI::ObjectHandle, RTI::ObjectClassHandle,
+           const RTI::AttributeHandleValuePairSet&, double);
+    void erase(RTI::ObjectHandle);
+
+    unsigned long suppressed ; // attribute values not forwarded
+
+private:
+    struct AttrSpec {
+        string name ;
+        RTI::AttributeHandle handle ;
+        Encoding encoding ;
+        double threshold ;
+    };
+    struct ClassSpec {
+        string name ;
+        RTI::ObjectClassHandle handle ;
+        double heartbeat ; // 0 : none
+        vector<AttrSpec> attributes ;
+    };
+    // Last forwarded state of an attribute
+    struct AttrState {
+        bool valid ;
+        double value ;
+        double rate ;
+        double time ;
+    };
+    struct ObjectState {
+        int spec ;
+        double last ; // time of the last forwarded update
+        vector<AttrState> attributes ;
+    };
+
+    int findClass(RTI::ObjectClassHandle);
+
+    vector<ClassSpec> specs ;
+    unordered_map<RTI::ObjectHandle, ObjectState> states ;
+    RTI::AttributeHandleValuePairSet* out ;
+    vector<double> values ;  // decoded values of the update being filtered
+    vector<int> positions ;  // their spec index, -1 for other attributes
+};
+
+#endif // DEAD_RECKONING_HH
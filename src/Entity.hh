@@ -23,6 +23,11 @@
 
 using namespace std ;
 
+// Transportation and order of an attribute or interaction class, as
+// declared by the FOM
+enum Transport { TRANSPORT_RELIABLE, TRANSPORT_BEST_EFFORT };
+enum Order { ORDER_TIMESTAMP, ORDER_RECEIVE };
+
 template<typename H>
 class Entity {
 
@@ -30,7 +35,9 @@ class Entity {
 protected:
     H handle ;
     string name ;
-    vector<H> tr ;
+    string space ; // routing space, empty if none
+    Transport transport ;
+    Order order ;
 
     // Methods
 public:
@@ -41,8 +48,12 @@ public:
     string getName();
     H getHandle();
     void setHandle(H);
-    void addTranslation(H);
-    H getTranslation(int);
+    string getSpace();
+    void setSpace(string);
+    Transport getTransport();
+    void setTransport(Transport);
+    Order getOrder();
+    void setOrder(Order);
 
     virtual void dump(void);
 };
@@ -54,6 +65,8 @@ Entity<H>::Entity(string s)
 {
     handle = 0 ;
     name = s ;
+    transport = TRANSPORT_RELIABLE ;
+    order = ORDER_TIMESTAMP ;
 }
 
 template<typename H>
@@ -61,6 +74,8 @@ Entity<H>::Entity(string s, H h)
 {
     handle = h ;
     name = s ;
+    transport = TRANSPORT_RELIABLE ;
+    order = ORDER_TIMESTAMP ;
 }
 
 template<typename H>
@@ -90,28 +105,53 @@ Entity<H>::setHandle(H h)
     handle = h ;
 }
 
+template<typename H>
+string
+Entity<H>::getSpace(void)
+{
+    return space ;
+}
+
 template<typename H>
 void
-Entity<H>::dump(void)
+Entity<H>::setSpace(string s)
 {
-    cout << "[" << handle << "|" << name << "|( " ;
-    for(int i=0; i<tr.size(); i++) cout << tr[i] << " " ;
-    cout << ")]" << endl ;
+    space = s ;
+}
+
+template<typename H>
+Transport
+Entity<H>::getTransport(void)
+{
+    return transport ;
 }
 
 template<typename H>
 void
-Entity<H>::addTranslation(H h)
+Entity<H>::setTransport(Transport t)
 {
-    tr.push_back(h);
+    transport = t ;
 }
 
 template<typename H>
-H
-Entity<H>::getTranslation(int i)
+Order
+Entity<H>::getOrder(void)
+{
+    return order ;
+}
+
+template<typename H>
+void
+Entity<H>::setOrder(Order o)
+{
+    order = o ;
+}
+
+template<typename H>
+void
+Entity<H>::dump(void)
 {
-    if(i>=0 && i<tr.size()) return tr[i] ;
-    else return 0 ;
+    cout << "[" << handle << "|" << name << "]" << endl ;
 }
 
 #endif // ENTITY_HH
@@ -103,6 +103,12 @@ void
 Fed::startRegistrationForObjectClass(RTI::ObjectClassHandle theClass)
     throw (RTI::ObjectClassNotPublished, RTI::FederateInternalError)
 {
+    if (verbose) {
+        cout << "Callback(" << id << ") - Start Registration For Object Class " 
+             << theClass << endl ;
+    }
+
+    federate->setObjectClassInterest(theClass, true);
 }
 
 // ---------------------------------------------------------------------------
@@ -112,6 +118,12 @@ void
 Fed::stopRegistrationForObjectClass(RTI::ObjectClassHandle theClass)
     throw (RTI::ObjectClassNotPublished, RTI::FederateInternalError)
 {
+    if (verbose) {
+        cout << "Callback(" << id << ") - Stop Registration For Object Class " 
+             << theClass << endl ;
+    }
+
+    federate->setObjectClassInterest(theClass, false);
 }
 
 // ---------------------------------------------------------------------------
@@ -120,6 +132,12 @@ Fed::stopRegistrationForObjectClass(RTI::ObjectClassHandle theClass)
 void Fed::turnInteractionsOff(RTI::InteractionClassHandle theHandle) 
     throw (RTI::InteractionClassNotPublished, RTI::FederateInternalError)
 {
+    if (verbose) {
+        cout << "Callback(" << id << ") - Turn Interactions Off " 
+             << theHandle << endl ;
+    }
+
+    federate->setInteractionInterest(theHandle, false);
 }
 
 // ---------------------------------------------------------------------------
@@ -129,7 +147,12 @@ void
 Fed::turnInteractionsOn(RTI::InteractionClassHandle theHandle) 
     throw (RTI::InteractionClassNotPublished, RTI::FederateInternalError)
 {
+    if (verbose) {
+        cout << "Callback(" << id << ") - Turn Interactions On " 
+             << theHandle << endl ;
+    }
 
+    federate->setInteractionInterest(theHandle, true);
 }
 
 // ===========================================================================
@@ -158,7 +181,21 @@ Fed::discoverObjectInstance(RTI::ObjectHandle handle,
     federate->discoverObject(handle, class_handle, name);
 }
 
-// FIXME: 3.4 provideAttributeValueUpdate
+// ---------------------------------------------------------------------------
+// 3.4 provideAttributeValueUpdate
+// ---------------------------------------------------------------------------
+void
+Fed::provideAttributeValueUpdate(RTI::ObjectHandle object,
+                                 const RTI::AttributeHandleSet& attributes)
+    throw (RTI::ObjectNotKnown, RTI::AttributeNotKnown, RTI::AttributeNotOwned,
+           RTI::FederateInternalError)
+{
+    if (verbose) {
+        cout << "Callback(" << id << ") - Provide Attribute Value Update "
+             << object << endl ;
+    }
+    federate->provide(object, attributes);
+}
 
 // ---------------------------------------------------------------------------
 // 3.5 receiveInteraction
@@ -217,8 +254,35 @@ Fed::removeObjectInstance(RTI::ObjectHandle object,
     federate->removeObject(object, time);
 }
 
-// FIXME: 3.8 turnUpdatesOffForObjectInstance 
-// FIXME: 3.9 turnUpdatesOnForObjectInstance 
+// ---------------------------------------------------------------------------
+// 3.8 turnUpdatesOffForObjectInstance
+// ---------------------------------------------------------------------------
+void
+Fed::turnUpdatesOffForObjectInstance(RTI::ObjectHandle object,
+                                     const RTI::AttributeHandleSet& attributes)
+    throw (RTI::ObjectNotKnown, RTI::AttributeNotOwned, RTI::FederateInternalError)
+{
+    if (verbose) {
+        cout << "Callback(" << id << ") - Turn Updates Off For Object Instance "
+             << object << endl ;
+    }
+    federate->turnUpdates(object, attributes, false);
+}
+
+// ---------------------------------------------------------------------------
+// 3.9 turnUpdatesOnForObjectInstance
+// ---------------------------------------------------------------------------
+void
+Fed::turnUpdatesOnForObjectInstance(RTI::ObjectHandle object,
+                                    const RTI::AttributeHandleSet& attributes)
+    throw (RTI::ObjectNotKnown, RTI::AttributeNotOwned, RTI::FederateInternalError)
+{
+    if (verbose) {
+        cout << "Callback(" << id << ") - Turn Updates On For Object Instance "
+             << object << endl ;
+    }
+    federate->turnUpdates(object, attributes, true);
+}
 
 // ===========================================================================
 // 4. OWNERSHIP MANAGEMENT
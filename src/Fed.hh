@@ -101,6 +101,19 @@ public:
               RTI::InvalidFederationTime, 
               RTI::FederateInternalError);
 
+    void provideAttributeValueUpdate(RTI::ObjectHandle theObject,
+                                     const RTI::AttributeHandleSet& theAttributes)
+        throw (RTI::ObjectNotKnown, RTI::AttributeNotKnown, RTI::AttributeNotOwned,
+               RTI::FederateInternalError);
+
+    void turnUpdatesOnForObjectInstance(RTI::ObjectHandle theObject,
+                                        const RTI::AttributeHandleSet& theAttributes)
+        throw (RTI::ObjectNotKnown, RTI::AttributeNotOwned, RTI::FederateInternalError);
+
+    void turnUpdatesOffForObjectInstance(RTI::ObjectHandle theObject,
+                                         const RTI::AttributeHandleSet& theAttributes)
+        throw (RTI::ObjectNotKnown, RTI::AttributeNotOwned, RTI::FederateInternalError);
+
     void receiveInteraction(RTI::InteractionClassHandle theInteraction, 
                             const RTI::ParameterHandleValuePairSet& theParameters, 
                             const RTI::FedTime& theTime, 
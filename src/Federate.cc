@@ -15,8 +15,12 @@
 //----------------------------------------------------------------------
 
 #include "Federate.hh"
+#include "Clock.hh"
+#include <algorithm>
 #include <stdio.h> // debug
 #include <unistd.h>
+#include <stdlib.h>
+#include <chrono>
 
 // ----------------------------------------------------------------------------
 // Federate
@@ -33,21 +37,45 @@ Federate::Federate(string federation_,
     federate = federate_ ;
     fedfile = fedfile_ ;
     host = host_ ;
-    filter = filter_ ;
+    // Legacy <filter> : a glob on the names of the hidden objects
+    if (!filter_.empty()) names.add(false, NameFilter::GLOB, filter_);
 
     joined = false ;
+    joinTries = 0 ;
+    joinBackoff = FEDERATE_JOIN_BACKOFF_MIN ;
+    joinTime = resolveTime = initTime = 0.0 ;
     constrained = false ;
     regulating = false ;
     verbose = false ;
     paused = false ;
+    threaded = false ;
+    stopping = NULL ;
+    waitPolicy = WAIT_SPIN ;
+    tickMin = FEDERATE_TICK_MIN ;
+    tickMax = FEDERATE_TICK_MAX ;
+    spinMax = FEDERATE_SPIN_MAX ;
+    spins = 0 ;
+    advancing = false ;
     id = -1 ;
+    board = NULL ;
+    grid = NULL ;
+    delta = false ;
+    advisories = false ;
 
-    certihost = "CERTI_HOST=" + host ;
-    putenv((char *) certihost.c_str());
+    // Copied into the environment : federates are deleted while the
+    // bridge runs, the environment must not point into them
+    setenv("CERTI_HOST", host.c_str(), 1);
 
     rtiamb = new RTI::RTIambassador();
     f = new Federation(rtiamb, fedfile);
     fedamb = new Fed(rtiamb, this, f);
+    inAttributes = RTI::AttributeSetFactory::create(8);
+    inParameters = RTI::ParameterSetFactory::create(8);
+    pendingAttributes = RTI::AttributeSetFactory::create(8);
+    deltaAttributes = RTI::AttributeSetFactory::create(8);
+    wantedAttributes = RTI::AttributeSetFactory::create(8);
+    providedAttributes = RTI::AttributeSetFactory::create(8);
+    sent.setLimit(FEDERATE_CACHE_SIZE);
 }
 
 // ----------------------------------------------------------------------------
@@ -56,6 +84,24 @@ Federate::Federate(string federation_,
 Federate::~Federate()
 {
     if (joined) this->resign();
+    for (vector<RTI::AttributeHandleValuePairSet*>::iterator i = 
+             outAttributes.begin() ; i != outAttributes.end() ; i++) {
+        delete *i ;
+    }
+    for (vector<RTI::ParameterHandleValuePairSet*>::iterator i = 
+             outParameters.begin() ; i != outParameters.end() ; i++) {
+        delete *i ;
+    }
+    for (vector<MessageChannel*>::iterator i = inbox.begin() ; 
+         i != inbox.end() ; i++) {
+        delete *i ;
+    }
+    delete inAttributes ;
+    delete inParameters ;
+    delete pendingAttributes ;
+    delete deltaAttributes ;
+    delete wantedAttributes ;
+    delete providedAttributes ;
     delete f ;
     delete fedamb ;
     delete rtiamb ;
@@ -72,6 +118,104 @@ Federate::setId(int i)
     f->setId(id);    
 }
 
+// ----------------------------------------------------------------------------
+// getId
+//
+int
+Federate::getId(void)
+{
+    return id ;
+}
+
+// ----------------------------------------------------------------------------
+// setWaitPolicy : how tick() waits for callbacks. WAIT_SPIN polls the RTI,
+// WAIT_BLOCK waits between min and max seconds in the RTI, WAIT_ADAPTIVE
+// polls spin times then blocks. The RTI goes on processing callbacks for at
+// least min seconds even when some arrive earlier, so every blocking tick
+// costs min seconds of latency.
+//
+void
+Federate::setWaitPolicy(WaitPolicy policy, double min, double max, int spin)
+{
+    waitPolicy = policy ;
+    tickMin = min ;
+    tickMax = max < min ? min : max ;
+    spinMax = spin ;
+}
+
+// ----------------------------------------------------------------------------
+// setCoalescing : updates of a same surrogate within window seconds (of
+// logical time) are merged and sent once. 0 disables coalescing.
+//
+void
+Federate::setCoalescing(double window)
+{
+    coalescer.setWindow(window);
+}
+
+// ----------------------------------------------------------------------------
+// setDelta : only forward the attributes whose value changed since the last
+// update of the surrogate
+//
+void
+Federate::setDelta(bool d)
+{
+    delta = d ;
+}
+
+// ----------------------------------------------------------------------------
+// setCacheLimit : size (in bytes) of the last values kept for the
+// surrogates
+//
+void
+Federate::setCacheLimit(size_t l)
+{
+    sent.setLimit(l);
+}
+
+// ----------------------------------------------------------------------------
+// getDeadReckoning : filter configuration, compiled by init()
+//
+DeadReckoning&
+Federate::getDeadReckoning(void)
+{
+    return deadReckoning ;
+}
+
+// ----------------------------------------------------------------------------
+// setAdvisories : only forward to this federate the classes that have
+// subscribers in its federation, according to the relevance advisories
+//
+void
+Federate::setAdvisories(bool a)
+{
+    advisories = a ;
+}
+
+// ----------------------------------------------------------------------------
+// tick : let the RTI deliver callbacks, according to the wait policy. Wait
+// loops reset spins before their first tick.
+//
+void
+Federate::tick(void)
+{
+    switch (waitPolicy) {
+      case WAIT_SPIN:
+        rtiamb->tick();
+        break ;
+      case WAIT_BLOCK:
+        rtiamb->tick(tickMin, tickMax);
+        break ;
+      case WAIT_ADAPTIVE:
+        if (spins < spinMax) {
+            spins++ ;
+            rtiamb->tick();
+        }
+        else rtiamb->tick(tickMin, tickMax);
+        break ;
+    }
+}
+
 // ----------------------------------------------------------------------------
 // setSynchro
 //
@@ -82,7 +226,10 @@ Federate::setSynchro(string s)
 }
 
 // ----------------------------------------------------------------------------
-// join
+// join : up to FEDERATE_JOIN_TRY_MAX tries, waiting longer after each
+// failure (the wait goes on growing over the next calls), then resolve the
+// handles of the FOM. Federates of different federations may join from
+// different threads.
 //
 int
 Federate::join(void)
@@ -91,8 +238,10 @@ Federate::join(void)
 
     if (joined) return 0 ;
 
-    while (!joined && tries < 3) {
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    while (!joined && tries < FEDERATE_JOIN_TRY_MAX) {
         tries++ ;
+        joinTries++ ;
         if (verbose) {
             cout << "Federate(" << id << ") - Trying to join federation "
                  << federation << "..." << endl ;
@@ -104,9 +253,11 @@ Federate::join(void)
             joined=true ;
         }
         catch (RTI::Exception &e) {
-            sleep(1);
+            usleep((useconds_t) (joinBackoff * 1000000.0));
+            joinBackoff = min(joinBackoff * 2.0, FEDERATE_JOIN_BACKOFF_MAX);
         }
     }
+    joinTime += Since(start);
 
     if (joined) {
         if (verbose) {
@@ -116,7 +267,9 @@ Federate::join(void)
     }
     else return -1 ;
 
+    start = chrono::steady_clock::now();
     f->update();
+    resolveTime = Since(start);
     return 0 ;
 }
 
@@ -128,6 +281,17 @@ Federate::resign(void)
 {
     //    f->resign(RTIfedTime(localTime->getTime() + lookahead->getTime()));
 
+    if (delta) {
+        cout << "Federate(" << id << ") - Delta forwarding saved " 
+             << sent.calls << " updates, " << sent.attributes 
+             << " attributes, " << sent.bytes << " bytes" << endl ;
+    }
+    if (deadReckoning.enabled()) {
+        cout << "Federate(" << id << ") - Dead reckoning suppressed " 
+             << deadReckoning.suppressed << " attribute values" << endl ;
+    }
+
+    f->deleteRegions();
     try {
         rtiamb->
             resignFederationExecution(RTI::DELETE_OBJECTS_AND_RELEASE_ATTRIBUTES);
@@ -148,21 +312,127 @@ Federate::resign(void)
 void
 Federate::connect(Federate &other)
 {
+    size_t t = f->connect(other.getFederation());
+    if (t < feds.size()) {
+        feds[t] = &other ; // slot of a removed peer
+        return ;
+    }
     feds.push_back(&other);
-    f->connect(other.getFederation());
+    outAttributes.push_back(RTI::AttributeSetFactory::create(8));
+    outParameters.push_back(RTI::ParameterSetFactory::create(8));
+}
+
+// ----------------------------------------------------------------------------
+// disconnect : forget a peer being removed. Its slot is kept (and reused by
+// the next connect) so that the translation indexes of the others stay.
+//
+void
+Federate::disconnect(Federate &other)
+{
+    for (size_t t = 0 ; t < feds.size() ; t++) {
+        if (feds[t] != &other) continue ;
+        feds[t] = NULL ;
+        f->disconnect(t);
+        return ;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// reroute : compile the routes again, once peers were added or removed
+//
+void
+Federate::reroute(void)
+{
+    vector<string> peers ;
+    for (vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+        peers.push_back(*i ? (*i)->getFederationName() : string());
+    }
+    routes.compile(*f, peers);
 }
 
 // ----------------------------------------------------------------------------
-// init
+// withdraw : delete the surrogates of the objects of this federation in the
+// peers, before it is removed
 //
 void
-Federate::init(void)
+Federate::withdraw(void)
 {
+    vector<RTI::ObjectHandle> surrogates ;
+    for (size_t t = 0 ; t < feds.size() ; t++) {
+        if (feds[t] == NULL) continue ;
+        f->getSurrogates(t, surrogates);
+        for (size_t i = 0 ; i < surrogates.size() ; i++) {
+            if (surrogates[i] != FEDERATE_PROXY) 
+                feds[t]->deleteObject(surrogates[i]);
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// init : barrier tells whether to wait for the synchronization point of the
+// federation ; a federation joined at runtime has passed it long ago
+//
+void
+Federate::init(bool barrier)
+{
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    deadReckoning.compile(*f);
+    positions.compile(*f);
+    names.compile();
+    this->reroute();
+    if (advisories) {
+        // Nothing is interesting until the RTI tells otherwise
+        interest.resize(f->getMaxObjectClassHandle() + 1, 
+                        f->getMaxInteractionClassHandle() + 1, false);
+        try {
+            rtiamb->enableClassRelevanceAdvisorySwitch();
+            rtiamb->enableInteractionRelevanceAdvisorySwitch();
+            rtiamb->enableAttributeRelevanceAdvisorySwitch();
+        }
+        catch (RTI::Exception &e) {
+            cout << "[RTI::Exception: Enable Advisories]" << endl ;
+        }
+    }
     f->publishAll();
     f->subscribeAll();
     this->setConstrained(true);
     this->setRegulating(true);
-    this->synchronize();
+    if (barrier) this->synchronize();
+    if (board) {
+        this->queryLBTS(localLBTS);
+        board->post(id, localLBTS.getTime());
+    }
+    initTime = Since(start);
+}
+
+// ----------------------------------------------------------------------------
+// timing : startup costs of the federate
+//
+void
+Federate::timing(void)
+{
+    cout << "Federate(" << id << ") - Startup of " << federation 
+         << " : join " << joinTime << "s (" << joinTries << " tries), "
+         << "handles " << resolveTime << "s, init " << initTime << "s" 
+         << endl ;
+}
+
+// ----------------------------------------------------------------------------
+// getFederationName
+//
+string
+Federate::getFederationName(void)
+{
+    return federation ;
+}
+
+// ----------------------------------------------------------------------------
+// getRoutes : destinations of the reflected classes, compiled by init()
+//
+RoutingTable&
+Federate::getRoutes(void)
+{
+    return routes ;
 }
 
 // ----------------------------------------------------------------------------
@@ -249,9 +519,10 @@ Federate::setRegulating(bool regulating_) {
                 requestTime += localLBTS ;
                 rtiamb->nextEventRequest(requestTime);
 
+                spins = 0 ;
                 while (!fedamb->getTAG()) {
                     try {
-                        rtiamb->tick();
+                        this->tick();
                     }
                     catch (RTI::RTIinternalError) {
                         printf ("RTIinternalError Raised in tick.\n");
@@ -279,14 +550,33 @@ Federate::setRegulating(bool regulating_) {
 }
 
 // ----------------------------------------------------------------------------
-// step
+// step : advance in time, waiting for the grant
 //
 bool
 Federate::step(void)
+{
+    this->request();
+    while (!this->poll()) {
+        if (threaded && *stopping) break ;
+    }
+    return true ;
+}
+
+// ----------------------------------------------------------------------------
+// request : first half of step, issue the time advance request without
+// waiting for the grant. Returns true if a grant is pending.
+//
+bool
+Federate::request(void)
 {
     //    rtiamb->tick();
 
+    if (threaded) this->drain();
+    this->flush();
+    this->answer();
+
     this->queryLBTS(localLBTS);
+    if (board) board->post(id, localLBTS.getTime());
     this->updateGlobalLBTS();
 
     if (lookahead != minLookahead) {
@@ -308,22 +598,18 @@ Federate::step(void)
     //        getchar();
 
     fedamb->setTAG(false);
+    advancing = false ;
+    spins = 0 ;
 
     if (timeRequest > localTime) {
         try {   
             rtiamb->timeAdvanceRequest(timeRequest);
             // rtiamb->nextEventRequest(*time_aux);
+            advancing = true ;
         }
         catch (RTI::Exception& e) {
             cout << "[RTI::Exception: Advance Request]" ;
         }
-        while (!fedamb->getTAG()) {
-            try {
-                rtiamb->tick();
-            }
-            catch (RTI::Exception& e) {
-            }
-        }
     }
     else {
         if (verbose) {
@@ -331,14 +617,174 @@ Federate::step(void)
         }
     }
 
+    if (!advancing) this->granted();
+    return advancing ;
+}
+
+// ----------------------------------------------------------------------------
+// poll : second half of step, tick once while the grant is pending. Returns
+// true once the federate has been granted (or did not request).
+//
+bool
+Federate::poll(void)
+{
+    if (!advancing) return true ;
+
+    // Pending timestamps must stay valid once the grant is delivered
+    this->flush();
+
+    try {
+        this->tick();
+    }
+    catch (RTI::Exception& e) {
+    }
+    if (threaded) this->drain();
+
+    if (fedamb->getTAG()) {
+        advancing = false ;
+        this->granted();
+    }
+    return !advancing ;
+}
+
+// ----------------------------------------------------------------------------
+// granted : end of a time step
+//
+void
+Federate::granted(void)
+{
     try {
         rtiamb->queryFederateTime(localTime);
     }
     catch (RTI::Exception& e) {
         cout << "[RTI::Exception: Query Federate Time]" ;
     }
+}
 
-    return true ;
+// ----------------------------------------------------------------------------
+// setObjectClassInterest : relevance advisory for a class published by this
+// federate
+//
+void
+Federate::setObjectClassInterest(RTI::ObjectClassHandle c, bool b)
+{
+    if (advisories) interest.setObjectClass(c, b);
+}
+
+// ----------------------------------------------------------------------------
+// hasObjectClassInterest : false if nobody subscribes to a class in this
+// federation. May be called from the thread of a peer.
+//
+bool
+Federate::hasObjectClassInterest(RTI::ObjectClassHandle c)
+{
+    return !advisories || interest.hasObjectClass(c);
+}
+
+// ----------------------------------------------------------------------------
+// setInteractionInterest
+//
+void
+Federate::setInteractionInterest(RTI::InteractionClassHandle c, bool b)
+{
+    if (advisories) interest.setInteraction(c, b);
+}
+
+// ----------------------------------------------------------------------------
+// hasInteractionInterest
+//
+bool
+Federate::hasInteractionInterest(RTI::InteractionClassHandle c)
+{
+    return !advisories || interest.hasInteraction(c);
+}
+
+// ----------------------------------------------------------------------------
+// turnUpdates : relevance advisory for attributes of a surrogate, see
+// update
+//
+void
+Federate::turnUpdates(RTI::ObjectHandle object, 
+                      const RTI::AttributeHandleSet& attributes, bool on)
+{
+    // The values dropped while muted never reached the cache : the values
+    // it holds may be stale, and new subscribers have none of them
+    if (on) sent.erase(object, attributes);
+
+    MuteMap::iterator m = muted.find(object);
+    if (m == muted.end()) {
+        if (on) return ;
+        m = muted.insert(make_pair(object, vector<RTI::AttributeHandle>())).first ;
+    }
+    vector<RTI::AttributeHandle> &v = m->second ;
+
+    for (RTI::ULong k = 0 ; k < attributes.size() ; k++) {
+        RTI::AttributeHandle h = attributes.getHandle(k);
+        vector<RTI::AttributeHandle>::iterator i = find(v.begin(), v.end(), h);
+        if (on && i != v.end()) v.erase(i);
+        else if (!on && i == v.end()) v.push_back(h);
+    }
+    if (v.empty()) muted.erase(m);
+}
+
+// ----------------------------------------------------------------------------
+// provide : provideAttributeValueUpdate for a surrogate. The callback comes
+// during a tick, possibly while a time advance is pending : the answer is
+// only queued, and sent by the next request.
+//
+void
+Federate::provide(RTI::ObjectHandle object, 
+                  const RTI::AttributeHandleSet& attributes)
+{
+    if (sent.find(object) == NULL) return ;
+
+    vector<RTI::AttributeHandle> &v = provides[object] ;
+    for (RTI::ULong k = 0 ; k < attributes.size() ; k++) {
+        RTI::AttributeHandle h = attributes.getHandle(k);
+        if (find(v.begin(), v.end(), h) == v.end()) v.push_back(h);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// answer : send the last values sent for the attributes queued by provide,
+// at the earliest time allowed. While a time advance is pending, the RTI
+// only accepts timestamps from the requested time plus the lookahead.
+//
+void
+Federate::answer(void)
+{
+    if (provides.empty()) return ;
+
+    RTIfedTime time((advancing ? timeRequest : localTime).getTime() 
+                    + lookahead.getTime());
+
+    for (ProvideMap::iterator i=provides.begin(); i!=provides.end(); i++) {
+        ValueCache::Record* r = sent.find(i->first);
+        if (r == NULL) continue ;
+
+        providedAttributes->empty();
+        for (size_t k = 0 ; k < i->second.size() ; k++) {
+            int j = r->find(i->second[k]);
+            if (j < 0) continue ;
+            providedAttributes->add(r->handles[j], r->values[j].data(), 
+                                    r->values[j].size());
+        }
+        if (providedAttributes->size() == 0) continue ;
+
+        if (verbose) {
+            cout << "Federate(" << id << ") - Provide " 
+                 << providedAttributes->size() << " attributes of object " 
+                 << i->first << " at " << time.getTime() << endl ;
+        }
+        try {
+            rtiamb->updateAttributeValues(i->first, *providedAttributes, 
+                                          time, "");
+        }
+        catch (RTI::Exception &e) {
+            cout << "EXCEPTION " << e._reason << endl ;
+        }
+    }
+    provides.clear();
 }
 
 // ----------------------------------------------------------------------------
@@ -350,6 +796,52 @@ Federate::queryLBTS(RTIfedTime &t)
     rtiamb->queryLBTS(t);
 }
 
+// ----------------------------------------------------------------------------
+// setBoard : share LBTS values through a board instead of querying the RTI
+// of every peer. Required in threaded mode.
+//
+void
+Federate::setBoard(LbtsBoard* b)
+{
+    board = b ;
+}
+
+// ----------------------------------------------------------------------------
+// setModel : canonical model shared by all the bridge federates
+//
+void
+Federate::setModel(CanonicalModel* m)
+{
+    f->setModel(m);
+}
+
+// ----------------------------------------------------------------------------
+// setGrid : areas of interest of the bridge federates
+//
+void
+Federate::setGrid(SpatialGrid* g)
+{
+    grid = g ;
+}
+
+// ----------------------------------------------------------------------------
+// getPositions : position attributes, compiled by init()
+//
+PositionTracker&
+Federate::getPositions(void)
+{
+    return positions ;
+}
+
+// ----------------------------------------------------------------------------
+// getNameFilter : include and exclude patterns, compiled by init()
+//
+NameFilter&
+Federate::getNameFilter(void)
+{
+    return names ;
+}
+
 // ----------------------------------------------------------------------------
 // updateGlobalLBTS
 //
@@ -363,7 +855,9 @@ Federate::updateGlobalLBTS(void)
     bool first = true ;
 
     for (vector<Federate*>::iterator i = feds.begin() ; i != feds.end() ; i++) {
-        (*i)->queryLBTS(fedLBTS);
+        if (*i == NULL) continue ;
+        if (board) fedLBTS = RTIfedTime(board->get((*i)->getId()));
+        else (*i)->queryLBTS(fedLBTS);
         if (first) {
             globalLBTS = fedLBTS ;
             first = false ;            
@@ -380,9 +874,10 @@ Federate::updateGlobalLBTS(void)
 void
 Federate::synchronize(void)
 {
+    spins = 0 ;
     while (!paused) {
         try {
-            rtiamb->tick();
+            this->tick();
         }
         catch (RTI::Exception& e) {
         }
@@ -396,9 +891,10 @@ Federate::synchronize(void)
     }
 
     cout << "Federation(" << id << ") - Synchronization..." << endl ;
+    spins = 0 ;
     while (paused) {
         try {
-            rtiamb->tick();
+            this->tick();
         }
         catch (RTI::Exception& e) {
 
@@ -441,9 +937,6 @@ Federate::discoverObject(RTI::ObjectHandle h,
                          RTI::ObjectClassHandle class_handle,
                          string name)
 {
-    bool discover ;
-
-    int t=0 ;
     if (!f->objectExists(h)) {
         if (verbose) {
             cout << "Federate(" << id << ") - Discovers new object, handle "
@@ -451,18 +944,21 @@ Federate::discoverObject(RTI::ObjectHandle h,
                  << endl ;
         }
 
-        if (filter.empty() || filter.compare(0, filter.size() - 1, name)) {
-            f->discoverObject(h, name);
-            for (vector<Federate*>::iterator i=feds.begin(); 
-                 i!=feds.end(); 
-                 i++) {
-                RTI::ObjectHandle surrogate = 
-                    (*i)->
-                    registerObject(f->getObjectClassTranslation(t, 
-                                                                class_handle),
-                                   name);
-                f->addObjectTranslation(h, surrogate);
-                t++ ;
+        if (names.accepts(name)) {
+            f->discoverObject(h, class_handle, name);
+            const vector<int> &to = routes.getObjectDestinations(class_handle);
+            for (vector<int>::const_iterator i=to.begin(); i!=to.end(); i++) {
+                int t = *i ;
+                RTI::ObjectClassHandle c = 
+                    f->getObjectClassTranslation(t, class_handle);
+                // Peers without subscribers, or interested in some areas
+                // only, get the object on its first update they are
+                // interested in, see reflect
+                bool located = grid && positions.tracks(class_handle) &&
+                    grid->restricts(feds[t]->getId());
+                if (!located && feds[t]->hasObjectClassInterest(c)) {
+                    this->introduce(t, h, c, name);
+                }
             }
         } else {
             if (verbose) {
@@ -473,7 +969,7 @@ Federate::discoverObject(RTI::ObjectHandle h,
     else {
         if (verbose) {
             cout << "Federate(" << id
-                 << ") - Discovers existing object, handle " << handle
+                 << ") - Discovers existing object, handle " << h
                  << ", class " << class_handle << ", name " << name 
                  << endl ;
         }
@@ -481,7 +977,34 @@ Federate::discoverObject(RTI::ObjectHandle h,
 }
 
 // ----------------------------------------------------------------------------
-// registerObject
+// introduce : register the surrogate of an object in peer t, of class c in
+// the peer federation
+//
+void
+Federate::introduce(int t, RTI::ObjectHandle h, RTI::ObjectClassHandle c,
+                    string name)
+{
+    if (c == 0) return ; // class not mapped in the peer
+
+    if (threaded) {
+        Message* m = this->post(t);
+        if (m) {
+            m->type = Message::DISCOVER ;
+            m->object = h ;
+            m->handle = c ;
+            m->name = name ;
+            outbox[t]->commit();
+            f->setObjectTranslation(t, h, FEDERATE_PROXY);
+        }
+    }
+    else {
+        RTI::ObjectHandle surrogate = feds[t]->registerObject(c, name);
+        f->setObjectTranslation(t, h, surrogate);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// registerObject : handle of the new object, 0 if the RTI refused it
 //
 RTI::ObjectHandle
 Federate::registerObject(RTI::ObjectClassHandle class_handle, string name)
@@ -491,7 +1014,15 @@ Federate::registerObject(RTI::ObjectClassHandle class_handle, string name)
              << ", class " << class_handle ;
     }
 
-    RTI::ObjectHandle h = rtiamb->registerObjectInstance(class_handle, name.c_str());
+    RTI::ObjectHandle h = 0 ;
+    try {
+        h = rtiamb->registerObjectInstance(class_handle, name.c_str());
+    }
+    catch (RTI::Exception &e) {
+        if (verbose) cout << endl ;
+        cout << "EXCEPTION " << e._reason << endl ;
+        return 0 ;
+    }
 
     if (verbose) {
         cout << ", (proxy) handle " << h << endl ;
@@ -508,20 +1039,90 @@ Federate::reflect(RTI::ObjectHandle object,
                   const RTI::AttributeHandleValuePairSet& attributes,
                   const RTI::FedTime& time)
 {
-    int t=0 ;
-    for (vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
-        RTI::ObjectHandle surrogate = f->getObjectTranslation(t, object);
+    RTI::ObjectClassHandle class_handle = 0 ;
+    RTI::ObjectHandle* surrogates = f->getObjectTranslations(object, 
+                                                             class_handle);
+    if (surrogates == NULL) return ; // hidden or unknown object
+
+    // Federates interested in the position of the object
+    SpatialGrid::Mask audience = ~0ULL ;
+    double x, y ;
+    if (grid && positions.locate(object, class_handle, attributes, x, y)) {
+        audience = grid->lookup(x, y);
+    }
+
+    const RTI::AttributeHandleValuePairSet* in = &attributes ;
+    if (deadReckoning.enabled()) {
+        in = &deadReckoning.filter(object, class_handle, attributes, 
+                                   ((RTIfedTime) time).getTime());
+        if (in->size() == 0) return ;
+    }
+
+    // Peers routed for the class, with a translation for it
+    const vector<int> &to = routes.getObjectDestinations(class_handle);
+    for (vector<int>::const_iterator i=to.begin(); i!=to.end(); i++) {
+        int t = *i ;
+        RTI::ObjectClassHandle c = 
+            f->getObjectClassTranslation(t, class_handle);
+        int peer = feds[t]->getId();
+        if (!feds[t]->hasObjectClassInterest(c) || 
+            (peer >= 0 && peer < SPATIAL_GRID_MAX_FEDERATES && 
+             !(audience & (1ULL << peer)))) {
+            continue ;
+        }
+        if (surrogates[t] == 0) {
+            this->introduce(t, object, c, f->getObjectName(object));
+            if (surrogates[t] == 0) continue ;
+        }
+
+        RTI::ObjectHandle surrogate = surrogates[t] ;
         if (verbose) {
             cout << "Federate(" << id << ") - Reflects object " << surrogate ;
             cout << " (proxy of " << object << " in " << t << ") at " 
                  << ((RTIfedTime) time).getTime() << endl ;
         }
 
-        (*i)->update(surrogate, attributes, time);
-        t++ ;
+        const RTI::AttributeHandleValuePairSet &out =
+            this->translateAttributes(t, class_handle, *in);
+        if (out.size() == 0) continue ;
+
+        if (threaded) {
+            Message* m = this->post(t);
+            if (m) {
+                m->type = Message::UPDATE ;
+                m->object = object ;
+                m->surrogate = surrogate ;
+                m->time = ((RTIfedTime) time).getTime();
+                RTI::ULong length ;
+                for (RTI::ULong k = 0 ; k < out.size() ; k++) {
+                    const char* value = out.getValuePointer(k, length);
+                    m->add(out.getHandle(k), value, length);
+                }
+                outbox[t]->commit();
+            }
+        }
+        else feds[t]->update(surrogate, out, time);
     }
 }
 
+// ----------------------------------------------------------------------------
+// translateAttributes : attribute set for peer t. Sets of classes whose
+// attributes keep the same handles in the peer are forwarded as is, others
+// are rebuilt into the outgoing set of the peer.
+//
+const RTI::AttributeHandleValuePairSet&
+Federate::translateAttributes(int t, 
+                              RTI::ObjectClassHandle class_handle,
+                              const RTI::AttributeHandleValuePairSet& attributes)
+{
+    if (f->isAttributeIdentity(t, class_handle)) return attributes ;
+
+    RTI::AttributeHandleValuePairSet* out = outAttributes[t] ;
+    out->empty();
+    f->translateAttributes(t, class_handle, attributes, *out);
+    return *out ;
+}
+
 // ----------------------------------------------------------------------------
 // receive
 //
@@ -530,33 +1131,119 @@ Federate::receive(RTI::InteractionClassHandle interaction,
                   const RTI::ParameterHandleValuePairSet& parameters,
                   const RTI::FedTime& time)
 {
-    int t=0 ;
-    for (vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+    const vector<int> &to = routes.getInteractionDestinations(interaction);
+    for (vector<int>::const_iterator i=to.begin(); i!=to.end(); i++) {
+        int t = *i ;
         RTI::InteractionClassHandle surrogate =
             f->getInteractionClassTranslation(t, interaction);
-        (*i)->send(surrogate, parameters, time);
-        t++ ;
+        if (!feds[t]->hasInteractionInterest(surrogate)) continue ;
+
+        const RTI::ParameterHandleValuePairSet &out =
+            this->translateParameters(t, interaction, parameters);
+        if (threaded) {
+            Message* m = this->post(t);
+            if (m) {
+                m->type = Message::INTERACTION ;
+                m->handle = surrogate ;
+                m->time = ((RTIfedTime) time).getTime();
+                RTI::ULong length ;
+                for (RTI::ULong k = 0 ; k < out.size() ; k++) {
+                    const char* value = out.getValuePointer(k, length);
+                    m->add(out.getHandle(k), value, length);
+                }
+                outbox[t]->commit();
+            }
+        }
+        else feds[t]->send(surrogate, out, time);
     }
 }
 
 // ----------------------------------------------------------------------------
-// update
+// translateParameters : parameter set for peer t, see translateAttributes
+//
+const RTI::ParameterHandleValuePairSet&
+Federate::translateParameters(int t, 
+                              RTI::InteractionClassHandle interaction,
+                              const RTI::ParameterHandleValuePairSet& parameters)
+{
+    if (f->isParameterIdentity(t, interaction)) return parameters ;
+
+    RTI::ParameterHandleValuePairSet* out = outParameters[t] ;
+    out->empty();
+    f->translateParameters(t, interaction, parameters, *out);
+    return *out ;
+}
+
+// ----------------------------------------------------------------------------
+// update : update a surrogate, or merge the update with the pending one
+// when coalescing. Attributes turned off by the RTI are not sent.
 //
 void
 Federate::update(RTI::ObjectHandle object,
                  const RTI::AttributeHandleValuePairSet& attributes,
                  const RTI::FedTime& time)
 {
+    // Drop the attributes nobody wants, and the update if none is left
+    const RTI::AttributeHandleValuePairSet* in = &attributes ;
+    MuteMap::iterator m = muted.find(object);
+    if (m != muted.end()) {
+        vector<RTI::AttributeHandle> &v = m->second ;
+        wantedAttributes->empty();
+        for (RTI::ULong k = 0 ; k < attributes.size() ; k++) {
+            RTI::AttributeHandle h = attributes.getHandle(k);
+            if (find(v.begin(), v.end(), h) != v.end()) continue ;
+            RTI::ULong length ;
+            const char* value = attributes.getValuePointer(k, length);
+            wantedAttributes->add(h, value, length);
+        }
+        if (wantedAttributes->size() == 0) return ;
+        in = wantedAttributes ;
+    }
+
+    if (!coalescer.enabled()) {
+        this->commit(object, *in, time);
+        return ;
+    }
+
+    double t = ((RTIfedTime) time).getTime();
+    Coalescer::Entry* e = coalescer.get(object, t);
+    if (!e->empty() && t - e->first > coalescer.getWindow()) {
+        e->fill(*pendingAttributes);
+        this->commit(object, *pendingAttributes, RTIfedTime(e->time));
+        e->reset(object, t);
+    }
+    else if (!e->empty()) coalescer.merged++ ;
+    e->merge(*in, t);
+}
+
+// ----------------------------------------------------------------------------
+// commit : send an update to the RTI, without the unchanged values in
+// delta mode
+//
+void
+Federate::commit(RTI::ObjectHandle object,
+                 const RTI::AttributeHandleValuePairSet& attributes,
+                 const RTI::FedTime& time)
+{
+    const RTI::AttributeHandleValuePairSet* out = &attributes ;
+    if (delta) {
+        if (sent.filter(object, attributes, *deltaAttributes) == 0) return ;
+        out = deltaAttributes ;
+    }
+
     if (verbose) {
         cout << "Federate(" << id << ") - Update object " << object << " at "
              << ((RTIfedTime) time).getTime() << "..." ;
     }
 
     try {
-        rtiamb->updateAttributeValues(object, attributes, time, "");
+        rtiamb->updateAttributeValues(object, *out, time, "");
+        if (!delta) sent.store(object, *out);
     }
     catch (RTI::Exception &e) {
         cout << "EXCEPTION " << e._reason << endl ;
+        // The values were not sent, do not filter them next time
+        if (delta) sent.erase(object);
         return ;
     }
     if (verbose) {
@@ -564,6 +1251,28 @@ Federate::update(RTI::ObjectHandle object,
     }
 }
 
+// ----------------------------------------------------------------------------
+// flush : send the pending (coalesced) updates
+//
+void
+Federate::flush(void)
+{
+    int n = coalescer.size();
+    if (n == 0) return ;
+
+    for (int i = 0 ; i < n ; i++) {
+        Coalescer::Entry* e = coalescer.at(i);
+        e->fill(*pendingAttributes);
+        this->commit(e->object, *pendingAttributes, RTIfedTime(e->time));
+    }
+    coalescer.clear();
+
+    if (verbose) {
+        cout << "Federate(" << id << ") - Flushed " << n << " updates ("
+             << coalescer.merged << " coalesced so far)" << endl ;
+    }
+}
+
 // ----------------------------------------------------------------------------
 // send
 void
@@ -585,13 +1294,31 @@ Federate::send(RTI::InteractionClassHandle interaction,
 void
 Federate::removeObject(RTI::ObjectHandle object, const RTI::FedTime& time)
 {
+    RTI::ObjectHandle* surrogates = f->getObjectTranslations(object);
+    if (surrogates == NULL) return ;
+
     int t=0 ;
     for (vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
-        RTI::ObjectHandle surrogate = f->getObjectTranslation(t, object);
-        (*i)->deleteObject(surrogate, time);
-        f->removeObject(object);
+        if (surrogates[t] == 0) { // never registered in this peer
+            t++ ;
+            continue ;
+        }
+        if (threaded) {
+            Message* m = this->post(t);
+            if (m) {
+                m->type = Message::REMOVE ;
+                m->object = object ;
+                m->surrogate = surrogates[t] ;
+                m->time = ((RTIfedTime) time).getTime();
+                outbox[t]->commit();
+            }
+        }
+        else (*i)->deleteObject(surrogates[t], time);
         t++ ;
     }
+    f->removeObject(object);
+    deadReckoning.erase(object);
+    positions.erase(object);
 }
 
 // ----------------------------------------------------------------------------
@@ -600,10 +1327,177 @@ Federate::removeObject(RTI::ObjectHandle object, const RTI::FedTime& time)
 void
 Federate::deleteObject(RTI::ObjectHandle object, const RTI::FedTime& time)
 {
+    // Pending updates come first, the object may be one of them
+    this->flush();
+    sent.erase(object);
+    muted.erase(object);
+
     if (verbose) {
         cout << "Federate(" << id << ") - Delete object " << object << endl ;
+    }
+    try {
         rtiamb->deleteObjectInstance(object, time, "");
     }
+    catch (RTI::Exception &e) {
+        cout << "EXCEPTION " << e._reason << endl ;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// deleteObject : receive order, for the surrogates of a federation being
+// removed (there is no time stamp to give them)
+//
+void
+Federate::deleteObject(RTI::ObjectHandle object)
+{
+    this->flush();
+    sent.erase(object);
+    muted.erase(object);
+
+    if (verbose) {
+        cout << "Federate(" << id << ") - Delete object " << object << endl ;
+    }
+    try {
+        rtiamb->deleteObjectInstance(object, "");
+    }
+    catch (RTI::Exception &e) {
+        cout << "EXCEPTION " << e._reason << endl ;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// link : open a channel to each peer, for the threaded mode. Must be called
+// on every federate before any of them is started.
+//
+void
+Federate::link(void)
+{
+    for (vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+        MessageChannel* c = new MessageChannel(FEDERATE_CHANNEL_SIZE);
+        outbox.push_back(c);
+        (*i)->accept(c);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// accept : take ownership of a channel from a peer
+//
+void
+Federate::accept(MessageChannel* c)
+{
+    inbox.push_back(c);
+}
+
+// ----------------------------------------------------------------------------
+// start : run the federate in its own thread until *stop becomes true. The
+// thread is the only one to use the RTI ambassador from now on.
+//
+void
+Federate::start(volatile bool* stop)
+{
+    stopping = stop ;
+    threaded = true ;
+    worker = thread(&Federate::run, this);
+}
+
+// ----------------------------------------------------------------------------
+// wait : join the thread started by start()
+//
+void
+Federate::wait(void)
+{
+    if (worker.joinable()) worker.join();
+}
+
+// ----------------------------------------------------------------------------
+// run : thread body
+//
+void
+Federate::run(void)
+{
+    if (verbose) {
+        cout << "Federate(" << id << ") - Thread started" << endl ;
+    }
+    while (!*stopping) {
+        this->step();
+    }
+}
+
+// ----------------------------------------------------------------------------
+// post : reserve a message in the channel to peer t. While the channel is
+// full, incoming messages are processed so that two federates waiting on
+// each other cannot deadlock. Returns NULL if the bridge is stopping.
+//
+Message*
+Federate::post(int t)
+{
+    Message* m ;
+    while ((m = outbox[t]->reserve()) == NULL) {
+        if (*stopping) return NULL ;
+        this->drain();
+        this_thread::yield();
+    }
+    m->clear();
+    m->origin = id ;
+    return m ;
+}
+
+// ----------------------------------------------------------------------------
+// drain : process every message waiting in the incoming channels
+//
+void
+Federate::drain(void)
+{
+    for (vector<MessageChannel*>::iterator i=inbox.begin(); 
+         i!=inbox.end(); i++) {
+        Message* m ;
+        while ((m = (*i)->front()) != NULL) {
+            this->process(*m);
+            (*i)->pop();
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// process : apply a message from a peer thread
+//
+void
+Federate::process(Message& m)
+{
+    unsigned long long key = ((unsigned long long) m.origin << 32) 
+        | (m.object & 0xffffffffUL) ;
+    RTI::ObjectHandle surrogate = m.surrogate ;
+    ProxyMap::iterator p ;
+
+    switch (m.type) {
+      case Message::DISCOVER:
+        surrogate = this->registerObject(m.handle, m.name);
+        if (surrogate) proxies[key] = surrogate ;
+        break ;
+      case Message::UPDATE:
+        if (surrogate == FEDERATE_PROXY) {
+            p = proxies.find(key);
+            if (p == proxies.end()) break ;
+            surrogate = p->second ;
+        }
+        m.fill(*inAttributes);
+        this->update(surrogate, *inAttributes, RTIfedTime(m.time));
+        break ;
+      case Message::INTERACTION:
+        m.fill(*inParameters);
+        this->send(m.handle, *inParameters, RTIfedTime(m.time));
+        break ;
+      case Message::REMOVE:
+        p = proxies.find(key);
+        if (p != proxies.end()) {
+            if (surrogate == FEDERATE_PROXY) surrogate = p->second ;
+            proxies.erase(p);
+        }
+        if (surrogate && surrogate != FEDERATE_PROXY) {
+            this->deleteObject(surrogate, RTIfedTime(m.time));
+        }
+        break ;
+    }
 }
 
 // ---------------------------------------------------------------------------
@@ -23,39 +23,88 @@
 #include <fedtime.hh>
 #include "Fed.hh"
 #include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
 
 #include "Federation.hh"
+#include "Channel.hh"
+#include "Message.hh"
+#include "LbtsBoard.hh"
+#include "Coalescer.hh"
+#include "ValueCache.hh"
+#include "DeadReckoning.hh"
+#include "Interest.hh"
+#include "SpatialGrid.hh"
+#include "PositionTracker.hh"
+#include "NameFilter.hh"
+#include "RoutingTable.hh"
 
 using std::cout ;
 using std::endl ;
 
 #define FEDERATE_JOIN_TRY_MAX 5
+#define FEDERATE_JOIN_BACKOFF_MIN 0.1 // seconds, doubled after each failure
+#define FEDERATE_JOIN_BACKOFF_MAX 2.0
 #define FEDERATE_ALREADY_JOINED -1
 #define FEDERATE_UNABLE_TO_JOIN -2
 
+#define FEDERATE_CHANNEL_SIZE 1024
+
+#define FEDERATE_TICK_MIN 0.0
+#define FEDERATE_TICK_MAX 0.1
+#define FEDERATE_SPIN_MAX 1000
+
+#define FEDERATE_CACHE_SIZE (16 * 1024 * 1024) // bytes
+
+// Surrogate registered by the peer thread, found in its proxy map
+#define FEDERATE_PROXY ((RTI::ObjectHandle) -1)
+
 using namespace std ;
 
 class Fed ;
 
+typedef Channel<Message> MessageChannel ;
+// Surrogates registered on behalf of a peer thread, indexed by
+// (source federate id << 32 | object handle in the source federation)
+typedef unordered_map<unsigned long long, RTI::ObjectHandle> ProxyMap ;
+// Attributes of surrogates whose updates were turned off by the RTI
+typedef unordered_map<RTI::ObjectHandle, vector<RTI::AttributeHandle> > MuteMap ;
+typedef unordered_map<RTI::ObjectHandle, vector<RTI::AttributeHandle> > ProvideMap ;
+
 class Federate
 {
     // ========================================================================
 public:
+    enum WaitPolicy { WAIT_SPIN, WAIT_BLOCK, WAIT_ADAPTIVE };
+
     Federate(string, string, string, string, string);
     ~Federate();
 
     void setSynchro(string);
+    void setWaitPolicy(WaitPolicy, double, double, int);
+    void setCoalescing(double);
+    void setDelta(bool);
+    void setCacheLimit(size_t);
+    DeadReckoning& getDeadReckoning(void);
+    void setAdvisories(bool);
 
     RTI::RTIambassador* getRTIAmbassador(void);
 
     void connect(Federate&);
+    void disconnect(Federate&);
+    void reroute(void);
+    void withdraw(void);
     Federation& getFederation(void);
+    string getFederationName(void);
+    RoutingTable& getRoutes(void);
 
     int join(void);
-    void init(void);
+    void init(bool);
     int resign(void);
     void synchronize(void);
     void info(void);
+    void timing(void);
   
     RTI::ObjectClassHandle getObjectClassHandle(string);
     RTI::AttributeHandle getAttributeHandle(string);
@@ -63,6 +112,8 @@ public:
     RTI::ParameterHandle getParameterHandle(string);
 
     bool step(void);
+    bool request(void);
+    bool poll(void);
 
     void announce(string);
     void endSynchronization(string);
@@ -83,12 +134,34 @@ public:
               const RTI::FedTime&);
     void removeObject(RTI::ObjectHandle, const RTI::FedTime&);
     void deleteObject(RTI::ObjectHandle, const RTI::FedTime&);
+    void deleteObject(RTI::ObjectHandle);
+
+    // Relevance advisories
+    void setObjectClassInterest(RTI::ObjectClassHandle, bool);
+    bool hasObjectClassInterest(RTI::ObjectClassHandle);
+    void setInteractionInterest(RTI::InteractionClassHandle, bool);
+    bool hasInteractionInterest(RTI::InteractionClassHandle);
+    void turnUpdates(RTI::ObjectHandle, const RTI::AttributeHandleSet&, bool);
+    void provide(RTI::ObjectHandle, const RTI::AttributeHandleSet&);
 
     void queryLBTS(RTIfedTime &);
     void updateGlobalLBTS(void);
+    void setBoard(LbtsBoard*);
+    void setGrid(SpatialGrid*);
+    void setModel(CanonicalModel*);
+    PositionTracker& getPositions(void);
+    NameFilter& getNameFilter(void);
+
+    // Threaded mode
+    void link(void);
+    void accept(MessageChannel*);
+    void start(volatile bool*);
+    void wait(void);
+    void drain(void);
 
     void setVerbose(bool);
     void setId(int);
+    int getId(void);
 
     // ========================================================================
 private:
@@ -96,20 +169,103 @@ private:
     void subscribeAll(void);
     void setConstrained(bool);
     void setRegulating(bool);  
+    void tick(void);
+    void granted(void);
+
+    const RTI::AttributeHandleValuePairSet& 
+    translateAttributes(int, RTI::ObjectClassHandle, 
+                        const RTI::AttributeHandleValuePairSet&);
+    const RTI::ParameterHandleValuePairSet& 
+    translateParameters(int, RTI::InteractionClassHandle, 
+                        const RTI::ParameterHandleValuePairSet&);
+
+    void commit(RTI::ObjectHandle, 
+                const RTI::AttributeHandleValuePairSet&,
+                const RTI::FedTime&);
+    void flush(void);
+    void answer(void);
+
+    void introduce(int, RTI::ObjectHandle, RTI::ObjectClassHandle, string);
+
+    void run(void);
+    Message* post(int);
+    void process(Message&);
 
     RTI::RTIambassador* rtiamb ;
     Fed* fedamb ;
-    vector<Federate*> feds ;
+    vector<Federate*> feds ; // by translation index, NULL once removed
     Federation* f ;
 
+    // Outgoing attribute and parameter sets, one per peer, reused by
+    // translateAttributes and translateParameters
+    vector<RTI::AttributeHandleValuePairSet*> outAttributes ;
+    vector<RTI::ParameterHandleValuePairSet*> outParameters ;
+
+    // Threaded mode : one channel to and from each peer. Incoming channels
+    // are owned (and deleted) by this federate.
+    bool threaded ;
+    volatile bool* stopping ;
+    thread worker ;
+    vector<MessageChannel*> outbox ;
+    vector<MessageChannel*> inbox ;
+    ProxyMap proxies ;
+    RTI::AttributeHandleValuePairSet* inAttributes ;
+    RTI::ParameterHandleValuePairSet* inParameters ;
+
+    // Updates of surrogates held back until the next time advance request
+    Coalescer coalescer ;
+    RTI::AttributeHandleValuePairSet* pendingAttributes ;
+
+    // Last values sent for each surrogate, compared to new ones in delta
+    // mode and used to answer provideAttributeValueUpdate
+    bool delta ;
+    ValueCache sent ;
+    RTI::AttributeHandleValuePairSet* deltaAttributes ;
+    RTI::AttributeHandleValuePairSet* providedAttributes ;
+    ProvideMap provides ; // requested in callbacks, answered by request
+
+    DeadReckoning deadReckoning ; // applied to reflected updates
+
+    // Subscribers in this federation, when the RTI advisories are used
+    bool advisories ;
+    Interest interest ;
+    MuteMap muted ;
+    RTI::AttributeHandleValuePairSet* wantedAttributes ;
+
+    LbtsBoard* board ; // shared by all the bridge federates, may be NULL
+
+    // Spatial interest : positions of the reflected objects, and areas of
+    // interest of all the bridge federates (shared, may be NULL)
+    PositionTracker positions ;
+    SpatialGrid* grid ;
+
+    // Objects discovered but not forwarded, by name
+    NameFilter names ;
+
+    // Peers receiving each reflected class
+    RoutingTable routes ;
+
     int id ;
     bool joined ;
+    int joinTries ;
+    double joinBackoff ; // seconds before the next try
+    // Startup costs, in seconds
+    double joinTime ;
+    double resolveTime ;
+    double initTime ;
     bool constrained ;
     bool regulating ;
     bool paused ;
     bool verbose ;
+    bool advancing ; // time advance requested, not granted yet
     RTI::FederateHandle handle ;
 
+    WaitPolicy waitPolicy ;
+    double tickMin ; // seconds
+    double tickMax ;
+    int spinMax ;    // non-blocking ticks before blocking (adaptive)
+    int spins ;
+
     RTIfedTime localTime ; // temps du federe
     RTIfedTime localLBTS ; // LBTS du federe
     RTIfedTime globalLBTS ; // min(LBTS) des autres federe
@@ -122,8 +278,6 @@ private:
     string fedfile ;
     string synchro ;
     string host ;
-    string filter ;
-    string certihost ;
 };
 
 #endif // FEDERATE_HH
@@ -15,6 +15,100 @@
 //----------------------------------------------------------------------
 
 #include "Federation.hh"
+#include "XmlProp.hh"
+#include <fstream>
+#include <iterator>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+// ---------------------------------------------------------------------------
+// SetDelivery : transportation and order of an XML attribute or interaction
+// class, reliable and time stamped unless told otherwise
+// 
+template<typename E>
+static void
+SetDelivery(E &e, xmlTextReaderPtr reader)
+{
+    string t = GetXmlProp(reader, ATTRIBUTE_TRANSPORTATION);
+    string o = GetXmlProp(reader, ATTRIBUTE_ORDER);
+    if (!xmlStrcmp((const xmlChar*) t.c_str(), VALUE_BESTEFFORT))
+        e.setTransport(TRANSPORT_BEST_EFFORT);
+    if (!xmlStrcmp((const xmlChar*) o.c_str(), VALUE_RO))
+        e.setOrder(ORDER_RECEIVE);
+}
+
+// ---------------------------------------------------------------------------
+// FedLexer : tokens of a .fed file, read in place from its text. Atoms are
+// symbols or quoted strings, ';' starts a comment up to the end of line.
+// 
+class FedLexer
+{
+public:
+    enum Token { OPEN, CLOSE, ATOM, END };
+
+    FedLexer(const char* b, size_t n) : line(1), p(b), end(b + n) { }
+
+    Token next(void)
+    {
+        while (p < end) {
+            if (*p == '\n') line++ ;
+            if (*p == ';') while (p < end && *p != '\n') p++ ;
+            else if (isspace((unsigned char) *p)) p++ ;
+            else break ;
+        }
+        if (p == end) return END ;
+        if (*p == '(') { p++ ; return OPEN ; }
+        if (*p == ')') { p++ ; return CLOSE ; }
+        if (*p == '"') {
+            text = ++p ;
+            while (p < end && *p != '"') if (*p++ == '\n') line++ ;
+            length = p - text ;
+            if (p < end) p++ ;
+            return ATOM ;
+        }
+        text = p ;
+        while (p < end && !isspace((unsigned char) *p) && *p != '(' && 
+               *p != ')' && *p != ';' && *p != '"') p++ ;
+        length = p - text ;
+        return ATOM ;
+    }
+    // Atom, compared without case
+    bool is(const char* s) const
+    {
+        return strlen(s) == length && !strncasecmp(text, s, length) ;
+    }
+    string atom(void) const { return string(text, length); }
+
+    const char* text ;
+    size_t length ;
+    int line ;
+
+private:
+    const char* p ;
+    const char* end ;
+};
+
+// ---------------------------------------------------------------------------
+// SetDelivery : transportation, order or routing space of an attribute or
+// interaction class, from one of the atoms following its name ; both the
+// HLA 1.3 keywords (reliable, timestamp...) and the FED_ ones are known
+// 
+template<typename E>
+static void
+SetDelivery(E &e, const FedLexer &lexer)
+{
+    if (lexer.is("reliable") || lexer.is("FED_RELIABLE"))
+        e.setTransport(TRANSPORT_RELIABLE);
+    else if (lexer.is("best_effort") || lexer.is("FED_BEST_EFFORT"))
+        e.setTransport(TRANSPORT_BEST_EFFORT);
+    else if (lexer.is("timestamp") || lexer.is("FED_TIMESTAMP"))
+        e.setOrder(ORDER_TIMESTAMP);
+    else if (lexer.is("receive") || lexer.is("FED_RECEIVE"))
+        e.setOrder(ORDER_RECEIVE);
+    else 
+        e.setSpace(lexer.atom());
+}
 
 // ---------------------------------------------------------------------------
 // Federation
@@ -22,7 +116,7 @@
 Federation::Federation(RTI::RTIambassador* rti, string fedfile)
 {
     rtiamb = rti ;
-    translations = 0 ;
+    model = NULL ;
     verbose = false ;
     id = -1 ;
 
@@ -46,6 +140,10 @@ Federation::update(void)
 {
     updateObjectClasses(sobj);
     updateInteractionClasses(sint);
+    updateSpaces();
+    publications.compile(*this);
+    subscriptions.compile(*this);
+    this->compile();
 }
 
 // ---------------------------------------------------------------------------
@@ -87,110 +185,211 @@ Federation::updateInteractionClasses(vector<IntClass> &intc)
 }
 
 // ---------------------------------------------------------------------------
-// addAttribute
+// updateSpaces : routing space and dimension handles
 // 
 void
-Federation::addAttribute(vector<ObjClass> &obj, string c, string a)
+Federation::updateSpaces(void)
 {
-    for(vector<ObjClass>::iterator i=obj.begin(); i!=obj.end(); i++) {
-        if(!i->getName().compare(c)) i->addAttribute(a) ;  
-        vector<ObjClass> &sub = i->getSubEntities();
-        if(sub.size()>0) this->addAttribute(sub, c, a);
+    for(vector<Space>::iterator i=spaces.begin(); i!=spaces.end(); i++) {
+        try {
+            RTI::SpaceHandle h = rtiamb->getRoutingSpaceHandle(i->getName().c_str());
+            i->setHandle(h);
+            vector<Dim> &d = i->getAttributes();
+            for(vector<Dim>::iterator j=d.begin(); j!=d.end(); j++) {
+                j->setHandle(rtiamb->getDimensionHandle(j->getName().c_str(), h));
+            }
+        }
+        catch (RTI::Exception &e) {
+            cout << "Warning: routing space " << i->getName() 
+                 << " not known by the RTI" << endl ;
+            i->setHandle(0);
+        }
     }
 }
 
 // ---------------------------------------------------------------------------
-// addSubObjectClass
+// dump
 // 
 void
-Federation::addSubObjectClass(string p, string c)
+Federation::dump(void)
 {
-    for(vector<ObjClass>::iterator i=sobj.begin(); i!=sobj.end(); i++) {
-        if(!i->getName().compare(p)) i->addSubEntity(c) ;  
-        // + les sous classes
+    if (verbose) {
+        for (vector<ObjClass>::iterator i=sobj.begin(); i!=sobj.end(); i++) {
+            i->dump();
+        }
+        for (vector<IntClass>::iterator i=sint.begin(); i!=sint.end(); i++) {
+            i->dump();
+        }
+        for (vector<Space>::iterator i=spaces.begin(); i!=spaces.end(); i++) {
+            i->dump();
+        }
     }
 }
 
 // ---------------------------------------------------------------------------
-// addSubInteractionClass
+// connect : translations to a peer go through the canonical model, the
+// tables of both federations are only extended with the identifiers that
+// are new to them. Returns the translation index of the peer : the slot of
+// a removed peer if any, so that the indexes of the others never change.
 // 
-void
-Federation::addSubInteractionClass(string p, string c)
+int
+Federation::connect(Federation &f)
 {
-    for(vector<ObjClass>::iterator i=sint.begin(); i!=sint.end(); i++) {
-        if(!i->getName().compare(p)) i->addSubEntity(c) ;  
-        // + les sous classes
-    }
+    size_t n = 0 ;
+    while (n < peers.size() && peers[n] != NULL) n++ ;
+    if (n == peers.size()) peers.push_back(&f);
+    else peers[n] = &f ;
+    // Rows of the objects already discovered get a column for a new peer
+    if(dobj.getPeers() != (int) peers.size()) dobj.setPeers(peers.size());
+    this->resolve();
+    f.resolve();
+    return n ;
 }
 
-
 // ---------------------------------------------------------------------------
-// addParameter
+// disconnect : remove peer n, and the surrogates of the objects in it
 // 
 void
-Federation::addParameter(string c, string a)
+Federation::disconnect(int n)
 {
-    for(vector<IntClass>::iterator i=sint.begin(); i!=sint.end(); i++)
-        if(!i->getName().compare(c)) i->addAttribute(a) ;  
+    if (n < 0 || n >= (int) peers.size()) return ;
+    peers[n] = NULL ;
+    dobj.clearPeer(n);
 }
 
 // ---------------------------------------------------------------------------
-// dump
+// setModel : canonical model shared by the federations of the bridge
 // 
 void
-Federation::dump(void)
+Federation::setModel(CanonicalModel* m)
 {
-    if (verbose) {
-        for (vector<ObjClass>::iterator i=sobj.begin(); i!=sobj.end(); i++) {
-            i->dump();
-        }
-        for (vector<IntClass>::iterator i=sint.begin(); i!=sint.end(); i++) {
-            i->dump();
-        }
-    }
+    model = m ;
 }
 
 // ---------------------------------------------------------------------------
-// connect
+// compile : map the class trees to the canonical model, into tables indexed
+// by class handle, so that translations need no tree walk. What is not
+// subscribed gets no canonical identifier and is never forwarded.
 // 
-void 
-Federation::connect(Federation &f)
+void
+Federation::compile(void)
 {
-    this->connectObjectClasses(sobj, f);
-    this->connectInteractionClasses(sint, f);
-    translations++ ;
+    vector<pair<string, Attr*> > attr ;
+    vector<pair<string, Param*> > param ;
+
+    if(model == NULL) return ;
+    objMap.clear();
+    intMap.clear();
+    this->compileObjectClasses(sobj, attr);
+    this->compileInteractionClasses(sint, param);
 }
 
 // ---------------------------------------------------------------------------
-// connectObjectClasses
+// compileObjectClasses : inherited holds the attributes of the parent
+// classes, with the name of their class
 // 
 void
-Federation::connectObjectClasses(vector<ObjClass> &v, Federation &f)
+Federation::compileObjectClasses(vector<ObjClass> &v, 
+                                 vector<pair<string, Attr*> > &inherited)
 {
-    for(vector<ObjClass>::iterator i=v.begin(); i!= v.end(); i++) {
-        i->addTranslation(f.getObjectClassHandle(i->getName()));
-        this->connectObjectClasses(i->getSubEntities(), f);
+    for(vector<ObjClass>::iterator i=v.begin(); i!=v.end(); i++) {
+        size_t mark = inherited.size();
         vector<Attr> &attr = i->getAttributes();
         for(vector<Attr>::iterator j=attr.begin(); j!=attr.end(); j++) {
-            j->addTranslation(f.getAttributeHandle(j->getName()));
+            inherited.push_back(make_pair(i->getName(), &*j));
+        }
+        RTI::ObjectClassHandle h = i->getHandle();
+        if(h) {
+            bool allowed = subscriptions.allowsClass(h);
+            objMap.setClass(h, allowed ? model->getObjectClass(i->getName()) : 0);
+            vector<CanonicalId> layout ;
+            for(vector<pair<string, Attr*> >::iterator j=inherited.begin(); 
+                j!=inherited.end(); j++) {
+                RTI::AttributeHandle a = j->second->getHandle();
+                CanonicalId id = model->getAttribute(j->first, 
+                                                     j->second->getName());
+                if(a >= layout.size()) layout.resize(a + 1, 0);
+                layout[a] = id ;
+                if(!allowed || !subscriptions.allowsAttribute(h, a)) id = 0 ;
+                objMap.setMember(h, a, id);
+            }
+            objMap.setLayout(h, model->getLayout(layout));
         }
+        this->compileObjectClasses(i->getSubEntities(), inherited);
+        inherited.resize(mark);
     }
 }
 
 // ---------------------------------------------------------------------------
-// connectInteractionClasses
+// compileInteractionClasses : inherited holds the parameters of the parent
+// classes, with the name of their class
 // 
 void
-Federation::connectInteractionClasses(vector<IntClass> &v, Federation &f)
+Federation::compileInteractionClasses(vector<IntClass> &v, 
+                                      vector<pair<string, Param*> > &inherited)
 {
-    for(vector<IntClass>::iterator i=v.begin(); i!= v.end(); i++) {
-        i->addTranslation(f.getInteractionClassHandle(i->getName()));
-        vector<IntClass> &sub=i->getSubEntities();
-        this->connectInteractionClasses(sub, f);
+    for(vector<IntClass>::iterator i=v.begin(); i!=v.end(); i++) {
+        size_t mark = inherited.size();
         vector<Param> &param = i->getAttributes();
         for(vector<Param>::iterator j=param.begin(); j!=param.end(); j++) {
-            j->addTranslation(f.getParameterHandle(j->getName()));
+            inherited.push_back(make_pair(i->getName(), &*j));
+        }
+        RTI::InteractionClassHandle h = i->getHandle();
+        if(h) {
+            bool allowed = subscriptions.allowsInteraction(h);
+            intMap.setClass(h, allowed ? 
+                            model->getInteractionClass(i->getName()) : 0);
+            vector<CanonicalId> layout ;
+            for(vector<pair<string, Param*> >::iterator j=inherited.begin(); 
+                j!=inherited.end(); j++) {
+                RTI::ParameterHandle p = j->second->getHandle();
+                CanonicalId id = model->getParameter(j->first, 
+                                                     j->second->getName());
+                if(p >= layout.size()) layout.resize(p + 1, 0);
+                layout[p] = id ;
+                intMap.setMember(h, p, id);
+            }
+            intMap.setLayout(h, model->getLayout(layout));
         }
+        this->compileInteractionClasses(i->getSubEntities(), inherited);
+        inherited.resize(mark);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// resolve : local handles of the canonical identifiers not resolved yet.
+// What is not published gets no local handle.
+// 
+void
+Federation::resolve(void)
+{
+    if(model == NULL) return ;
+
+    CanonicalId n = model->getObjectClassCount();
+    for(CanonicalId k=objMap.getLocalClassCount()+1; k<=n; k++) {
+        RTI::ObjectClassHandle h = 
+            this->getObjectClassHandle(model->getObjectClassName(k));
+        if(h && !publications.allowsClass(h)) h = 0 ;
+        objMap.setLocalClass(k, h);
+    }
+    n = model->getAttributeCount();
+    for(CanonicalId k=objMap.getLocalMemberCount()+1; k<=n; k++) {
+        objMap.setLocalMember(k, 
+                              this->getAttributeHandle(model->getAttributeOwner(k),
+                                                       model->getAttributeName(k)));
+    }
+    n = model->getInteractionClassCount();
+    for(CanonicalId k=intMap.getLocalClassCount()+1; k<=n; k++) {
+        RTI::InteractionClassHandle h = 
+            this->getInteractionClassHandle(model->getInteractionClassName(k));
+        if(h && !publications.allowsInteraction(h)) h = 0 ;
+        intMap.setLocalClass(k, h);
+    }
+    n = model->getParameterCount();
+    for(CanonicalId k=intMap.getLocalMemberCount()+1; k<=n; k++) {
+        intMap.setLocalMember(k, 
+                              this->getParameterHandle(model->getParameterOwner(k),
+                                                       model->getParameterName(k)));
     }
 }
 
@@ -200,7 +399,7 @@ Federation::connectInteractionClasses(vector<IntClass> &v, Federation &f)
 RTI::ObjectClassHandle
 Federation::getObjectClassHandle(string s)
 {
-    return this->searchObjectClassHandle(sobj, s) ;
+    return this->searchClassHandle(objIndex, s) ;
 }
 
 // ---------------------------------------------------------------------------
@@ -212,13 +411,22 @@ Federation::getAttributeHandle(string s)
     return this->searchAttributeHandle(sobj, s) ;
 }
 
+// ---------------------------------------------------------------------------
+// getAttributeHandle : attribute of a given class (or of its parents)
+// 
+RTI::AttributeHandle
+Federation::getAttributeHandle(string c, string s)
+{
+    return this->searchMemberHandle(objIndex, c, s);
+}
+
 // ---------------------------------------------------------------------------
 // getInteractionClassHandle
 // 
 RTI::InteractionClassHandle
 Federation::getInteractionClassHandle(string s)
 {
-    return this->searchInteractionClassHandle(sint, s) ;
+    return this->searchClassHandle(intIndex, s) ;
 }
 
 // ---------------------------------------------------------------------------
@@ -231,14 +439,39 @@ Federation::getParameterHandle(string s)
 }
 
 // ---------------------------------------------------------------------------
-// searchObjectClassHandle
+// getParameterHandle : parameter of a given class (or of its parents)
 // 
-RTI::ObjectClassHandle
-Federation::searchObjectClassHandle(vector<ObjClass> &v, string &s)
+RTI::ParameterHandle
+Federation::getParameterHandle(string c, string s)
 {
-    for(vector<ObjClass>::iterator i=v.begin(); i!=v.end(); i++) {
-        if(!i->getName().compare(s)) return i->getHandle();
-        else return this->searchObjectClassHandle(i->getSubEntities(), s);
+    return this->searchMemberHandle(intIndex, c, s);
+}
+
+// ---------------------------------------------------------------------------
+// searchClassHandle
+// 
+RTI::ULong
+Federation::searchClassHandle(ClassIndex &index, string &s)
+{
+    ClassIndex::iterator i = index.find(s);
+    return i == index.end() ? 0 : i->second.first->getHandle();
+}
+
+// ---------------------------------------------------------------------------
+// searchMemberHandle : member s of class c, or of the nearest of its
+// parents declaring it
+// 
+RTI::ULong
+Federation::searchMemberHandle(ClassIndex &index, string &c, string &s)
+{
+    ClassIndex::iterator i = index.find(c);
+    while (i != index.end()) {
+        vector<Attr> &attr = i->second.first->getAttributes();
+        for(vector<Attr>::reverse_iterator j=attr.rbegin(); j!=attr.rend(); j++) {
+            if(!j->getName().compare(s)) return j->getHandle();
+        }
+        if (i->second.second == NULL) break ;
+        i = index.find(i->second.second->getName());
     }
     return 0 ;
 }
@@ -260,19 +493,6 @@ Federation::searchAttributeHandle(vector<ObjClass> &v, string &s)
     return 0;
 }
 
-// ---------------------------------------------------------------------------
-// searchInteractionClassHandle
-// 
-RTI::InteractionClassHandle
-Federation::searchInteractionClassHandle(vector<IntClass> &v, string &s)
-{
-    for(vector<IntClass>::iterator i=v.begin(); i!=v.end(); i++) {
-        if(!i->getName().compare(s)) return i->getHandle();
-        else return this->searchInteractionClassHandle(i->getSubEntities(), s);
-    }
-    return 0 ;
-}
-
 // ---------------------------------------------------------------------------
 // searchParameterHandle
 // 
@@ -296,7 +516,8 @@ Federation::searchParameterHandle(vector<IntClass> &v, string &s)
 void
 Federation::publishAll(void)
 {
-    this->publishAllObjectClasses(sobj);
+    vector<Attr*> attr ;
+    this->publishAllObjectClasses(sobj, attr);
     this->publishAllInteractionClasses(sint); 
     if (verbose) {
         cout << "Federation(" << id << ") - Publications done" << endl ;
@@ -304,26 +525,44 @@ Federation::publishAll(void)
 }
 
 // ---------------------------------------------------------------------------
-// publishAllObjectClasses
+// publishAllObjectClasses : inherited holds the attributes of the parent
+// classes, published with the listed classes only
 // 
 void
-Federation::publishAllObjectClasses(vector<ObjClass> &v)
+Federation::publishAllObjectClasses(vector<ObjClass> &v, 
+                                    vector<Attr*> &inherited)
 {
     for(vector<ObjClass>::iterator i=v.begin(); i!=v.end(); i++) {
         // Preparing attributes
         vector<Attr> &attr = i->getAttributes();
         RTI::AttributeHandleSet *handles ;
-        handles = RTI::AttributeHandleSetFactory::create(i->getAttributes().size());    
+        handles = RTI::AttributeHandleSetFactory::create(inherited.size() + 
+                                                         attr.size());
+        RTI::ObjectClassHandle h = i->getHandle();
+        if(publications.restrictsClasses()) {
+            for(vector<Attr*>::iterator a=inherited.begin(); 
+                a!=inherited.end(); a++) {
+                if(publications.allowsAttribute(h, (*a)->getHandle()))
+                    handles->add((*a)->getHandle());
+            }
+        }
+        size_t mark = inherited.size();
         for(vector<Attr>::iterator a=attr.begin(); a!=attr.end(); a++) {
-            handles->add(a->getHandle());
+            if(publications.allowsAttribute(h, a->getHandle()))
+                handles->add(a->getHandle());
+            inherited.push_back(&*a);
         }
 
         // publish
-        rtiamb->publishObjectClass(i->getHandle(), *handles);
+        if(publications.allowsClass(h)) {
+            rtiamb->publishObjectClass(h, *handles);
+        }
         handles->empty();
+        delete handles ;
 
         // Now the sub classes
-        this->publishAllObjectClasses(i->getSubEntities());
+        this->publishAllObjectClasses(i->getSubEntities(), inherited);
+        inherited.resize(mark);
     }
 }
 
@@ -334,8 +573,11 @@ void
 Federation::publishAllInteractionClasses(vector<IntClass> &v)
 {
     for(vector<IntClass>::iterator i=v.begin(); i!=v.end(); i++) {    
-        rtiamb->publishInteractionClass(i->getHandle());
-        //this->publishAllInteractionClasses(i->getSubEntities()); 
+        if(publications.allowsInteraction(i->getHandle())) {
+            rtiamb->publishInteractionClass(i->getHandle());
+        }
+        // Listed sub classes of a class not listed
+        else this->publishAllInteractionClasses(i->getSubEntities()); 
     }
 }
 
@@ -345,30 +587,224 @@ Federation::publishAllInteractionClasses(vector<IntClass> &v)
 void
 Federation::subscribeAll(void)
 {
-    this->subscribeAllObjectClasses(sobj);
+    vector<Attr*> attr ;
+    this->createRegions();
+    this->subscribeAllObjectClasses(sobj, attr);
     this->subscribeAllInteractionClasses(sint); 
     if (verbose) {
         cout << "Federation(" << id << ") - Subscriptions done" << endl ;
     }
 }
 // ---------------------------------------------------------------------------
-// subscribeAllObjectClasses
+// addRegionExtent : add an extent to the subscription region of a routing
+// space
+// 
+void
+Federation::addRegionExtent(string space, const RegionExtent &e)
+{
+    extents[space].push_back(e);
+}
+
+// ---------------------------------------------------------------------------
+// getPublications : what the bridge may publish to this federation
+// 
+AllowList&
+Federation::getPublications(void)
+{
+    return publications ;
+}
+
+// ---------------------------------------------------------------------------
+// getSubscriptions : what the bridge may subscribe from this federation
+// 
+AllowList&
+Federation::getSubscriptions(void)
+{
+    return subscriptions ;
+}
+
+// ---------------------------------------------------------------------------
+// createRegions : create the subscription regions, once the handles are
+// known
+// 
+void
+Federation::createRegions(void)
+{
+    for(map<string, vector<RegionExtent> >::iterator i=extents.begin(); 
+        i!=extents.end(); i++) {
+        Space* space = this->findSpace(i->first);
+        if(space == NULL || space->getHandle() == 0) {
+            cout << "Warning: region of unknown routing space " << i->first 
+                 << endl ;
+            continue ;
+        }
+        try {
+            RTI::Region* r = rtiamb->createRegion(space->getHandle(), 
+                                                  i->second.size());
+            for(size_t e=0; e<i->second.size(); e++) {
+                RegionExtent &extent = i->second[e] ;
+                for(RegionExtent::iterator b=extent.begin(); b!=extent.end(); b++) {
+                    RTI::DimensionHandle d = 0 ;
+                    vector<Dim> &dims = space->getAttributes();
+                    for(vector<Dim>::iterator j=dims.begin(); j!=dims.end(); j++) {
+                        if(j->getName() == b->dimension) d = j->getHandle();
+                    }
+                    if(d == 0) {
+                        cout << "Warning: unknown dimension " << b->dimension 
+                             << " in routing space " << i->first << endl ;
+                        continue ;
+                    }
+                    r->setRangeLowerBound(e, d, b->lower);
+                    r->setRangeUpperBound(e, d, b->upper);
+                }
+            }
+            // The bounds only reach the RTI with this call
+            rtiamb->notifyAboutRegionModification(*r);
+            regions[i->first] = r ;
+            if (verbose) {
+                cout << "Federation(" << id << ") - Region of " << i->first 
+                     << " with " << i->second.size() << " extents" << endl ;
+            }
+        }
+        catch (RTI::Exception &e) {
+            cout << "Warning: cannot create region of " << i->first << endl ;
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// deleteRegions : release the subscription regions, before resigning ; a
+// region still used by a subscription cannot be deleted
+// 
+void
+Federation::deleteRegions(void)
+{
+    for(size_t k=0; k<regionClasses.size(); k++) {
+        try {
+            rtiamb->unsubscribeObjectClassWithRegion(regionClasses[k].first, 
+                                                     *regionClasses[k].second);
+        }
+        catch (RTI::Exception &e) {
+            cerr << "Warning: cannot unsubscribe class " 
+                 << regionClasses[k].first << " with region: " 
+                 << e._name << endl ;
+        }
+    }
+    for(size_t k=0; k<regionInteractions.size(); k++) {
+        try {
+            rtiamb->unsubscribeInteractionClassWithRegion(
+                regionInteractions[k].first, *regionInteractions[k].second);
+        }
+        catch (RTI::Exception &e) {
+            cerr << "Warning: cannot unsubscribe interaction " 
+                 << regionInteractions[k].first << " with region: " 
+                 << e._name << endl ;
+        }
+    }
+    regionClasses.clear();
+    regionInteractions.clear();
+
+    for(map<string, RTI::Region*>::iterator i=regions.begin(); 
+        i!=regions.end(); i++) {
+        try {
+            rtiamb->deleteRegion(i->second);
+        }
+        catch (RTI::Exception &e) {
+            cerr << "Warning: cannot delete region of " << i->first << ": " 
+                 << e._name << endl ;
+        }
+    }
+    regions.clear();
+}
+
+// ---------------------------------------------------------------------------
+// findSpace : routing space of a given name, NULL if none
+// 
+Space*
+Federation::findSpace(string name)
+{
+    for(vector<Space>::iterator i=spaces.begin(); i!=spaces.end(); i++) {
+        if(i->getName() == name) return &*i ;
+    }
+    return NULL ;
+}
+
+// ---------------------------------------------------------------------------
+// findRegion : subscription region of a routing space, NULL if none
+// 
+RTI::Region*
+Federation::findRegion(string space)
+{
+    if(space.empty()) return NULL ;
+    map<string, RTI::Region*>::iterator i = regions.find(space);
+    if(i == regions.end()) return NULL ;
+    return i->second ;
+}
+
+// ---------------------------------------------------------------------------
+// subscribeAllObjectClasses : inherited holds the attributes of the parent
+// classes, subscribed with the listed classes only
 // 
 void
-Federation::subscribeAllObjectClasses(vector<ObjClass> &v)
+Federation::subscribeAllObjectClasses(vector<ObjClass> &v, 
+                                      vector<Attr*> &inherited)
 {
     for(vector<ObjClass>::iterator i=v.begin(); i!=v.end(); i++) {
+        size_t mark = inherited.size();
+        vector<Attr> &own = i->getAttributes();
+        for(vector<Attr>::iterator a=own.begin(); a!=own.end(); a++) {
+            inherited.push_back(&*a);
+        }
+        RTI::ObjectClassHandle h = i->getHandle();
+        if(!subscriptions.allowsClass(h)) {
+            // Listed sub classes of a class not listed
+            this->subscribeAllObjectClasses(i->getSubEntities(), inherited);
+            inherited.resize(mark);
+            continue ;
+        }
+
         // Preparing attributes
-        vector<Attr> &attr = i->getAttributes();
+        vector<Attr*> attr ;
+        size_t first = subscriptions.restrictsClasses() ? 0 : mark ;
+        for(size_t k=first; k<inherited.size(); k++) {
+            if(subscriptions.allowsAttribute(h, inherited[k]->getHandle()))
+                attr.push_back(inherited[k]);
+        }
+        inherited.resize(mark);
         RTI::AttributeHandleSet *handles ;
-        handles = RTI::AttributeHandleSetFactory::create(i->getAttributes().size());    
-        for(vector<Attr>::iterator a=attr.begin(); a!=attr.end(); a++) {
-            handles->add(a->getHandle());
+        handles = RTI::AttributeHandleSetFactory::create(attr.size());    
+
+        // Attributes of a routing space with a region are subscribed
+        // with that region, the others without region
+        vector<pair<RTI::Region*, RTI::AttributeHandleSet*> > sets ;
+        for(vector<Attr*>::iterator a=attr.begin(); a!=attr.end(); a++) {
+            RTI::Region* r = this->findRegion((*a)->getSpace());
+            if(r == NULL) {
+                handles->add((*a)->getHandle());
+                continue ;
+            }
+            size_t k = 0 ;
+            while(k<sets.size() && sets[k].first!=r) k++ ;
+            if(k == sets.size()) {
+                sets.push_back(make_pair(r, 
+                                         RTI::AttributeHandleSetFactory::create(attr.size())));
+            }
+            sets[k].second->add((*a)->getHandle());
         }
 
         // publish
-        rtiamb->subscribeObjectClassAttributes(i->getHandle(), *handles);
+        if(handles->size()>0 || sets.empty()) {
+            rtiamb->subscribeObjectClassAttributes(i->getHandle(), *handles);
+        }
         handles->empty();
+        delete handles ;
+        for(size_t k=0; k<sets.size(); k++) {
+            rtiamb->subscribeObjectClassAttributesWithRegion(i->getHandle(), 
+                                                             *sets[k].first,
+                                                             *sets[k].second);
+            regionClasses.push_back(make_pair(i->getHandle(), sets[k].first));
+            delete sets[k].second ;
+        }
 
         // Now the sub classes
         // Commented out: CERTI would send 2 RAV for the same UAV
@@ -384,32 +820,42 @@ void
 Federation::subscribeAllInteractionClasses(vector<IntClass> &v)
 {
     for(vector<IntClass>::iterator i=v.begin(); i!=v.end(); i++) {    
-        rtiamb->subscribeInteractionClass(i->getHandle());
+        if(!subscriptions.allowsInteraction(i->getHandle())) {
+            this->subscribeAllInteractionClasses(i->getSubEntities());
+            continue ;
+        }
+        RTI::Region* r = this->findRegion(i->getSpace());
+        if(r) {
+            rtiamb->subscribeInteractionClassWithRegion(i->getHandle(), *r);
+            regionInteractions.push_back(make_pair(i->getHandle(), r));
+        }
+        else rtiamb->subscribeInteractionClass(i->getHandle());
         //this->subscribeAllInteractionClasses(i->getSubEntities()); 
     }
 }
 
 // ---------------------------------------------------------------------------
-// addTranslation
+// setObjectTranslation : record the surrogate of an object in peer n
 // 
 void
-Federation::addObjectTranslation(RTI::ObjectHandle object, RTI::ObjectHandle surrogate)
+Federation::setObjectTranslation(int n, RTI::ObjectHandle object, 
+                                 RTI::ObjectHandle surrogate)
 {
-    for(vector<Obj>::iterator i=dobj.begin(); i!=dobj.end(); i++) {
-        if(i->getHandle()==object) i->addTranslation(surrogate);
-    }
+    RTI::ObjectHandle* row = dobj.findRow(object);
+    if(row && n>=0 && n<(int) peers.size()) row[n] = surrogate ;
 }
 
 // ---------------------------------------------------------------------------
 // discoverObject
 // 
 void
-Federation::discoverObject(RTI::ObjectHandle handle, string name)
+Federation::discoverObject(RTI::ObjectHandle handle, 
+                           RTI::ObjectClassHandle class_handle, 
+                           string name)
 {
-    if(!this->objectExists(handle)) {
-        dobj.push_back(Obj(name, handle));
-    }
-    else cout << "WARNING: Federation RE-discovers object " << handle
+    if(dobj.getPeers() != (int) peers.size()) dobj.setPeers(peers.size());
+    if(dobj.insert(handle, class_handle, name) < 0)
+        cout << "WARNING: Federation RE-discovers object " << handle
               << endl ;
 }
 
@@ -419,16 +865,8 @@ Federation::discoverObject(RTI::ObjectHandle handle, string name)
 void 
 Federation::removeObject(RTI::ObjectHandle handle)
 {
-    if(this->objectExists(handle)) {
-        //    printf("Federation removes object %u\n", handle);
-        for(vector<Obj>::iterator i=dobj.begin(); i!=dobj.end(); i++) {
-            if(i->getHandle()==handle) {
-                dobj.erase(i);
-                return ;
-            }
-        }
-    }
-    else printf("WARNING: Federation asked to remove unknown object %u", handle);
+    if(!dobj.erase(handle))
+        printf("WARNING: Federation asked to remove unknown object %lu\n", handle);
 }
 
 // ---------------------------------------------------------------------------
@@ -437,10 +875,83 @@ Federation::removeObject(RTI::ObjectHandle handle)
 bool
 Federation::objectExists(RTI::ObjectHandle handle)
 {
-    for(vector<Obj>::iterator i=dobj.begin(); i!=dobj.end(); i++) {
-        if(i->getHandle()==handle) return true ;
+    return dobj.exists(handle);
+}
+
+// ---------------------------------------------------------------------------
+// getSurrogates : objects registered in peer n for the discovered objects
+//
+void
+Federation::getSurrogates(int n, vector<RTI::ObjectHandle> &v)
+{
+    v.clear();
+    if (n < 0 || n >= dobj.getPeers()) return ;
+    for (int i = 0 ; i < dobj.capacity() ; i++) {
+        if (dobj.getHandle(i) && dobj.getRow(i)[n]) 
+            v.push_back(dobj.getRow(i)[n]);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// getObjectName : name of a discovered object, empty if unknown
+//
+string
+Federation::getObjectName(RTI::ObjectHandle handle)
+{
+    int slot = dobj.find(handle);
+    if(slot < 0) return "" ;
+    return dobj.getName(slot);
+}
+
+// ---------------------------------------------------------------------------
+// getMaxObjectClassHandle
+// 
+RTI::ObjectClassHandle
+Federation::getMaxObjectClassHandle(void)
+{
+    return this->searchMaxHandle(sobj);
+}
+
+// ---------------------------------------------------------------------------
+// getMaxInteractionClassHandle
+// 
+RTI::InteractionClassHandle
+Federation::getMaxInteractionClassHandle(void)
+{
+    return this->searchMaxHandle(sint);
+}
+
+// ---------------------------------------------------------------------------
+// getObjectClasses : object class tree of the FOM
+// 
+vector<ObjClass>&
+Federation::getObjectClasses(void)
+{
+    return sobj ;
+}
+
+// ---------------------------------------------------------------------------
+// getInteractionClasses : interaction class tree of the FOM
+// 
+vector<IntClass>&
+Federation::getInteractionClasses(void)
+{
+    return sint ;
+}
+
+// ---------------------------------------------------------------------------
+// searchMaxHandle : highest class handle in a class tree
+// 
+RTI::ULong
+Federation::searchMaxHandle(vector<ObjClass> &v)
+{
+    RTI::ULong max = 0 ;
+    for(vector<ObjClass>::iterator i=v.begin(); i!=v.end(); i++) {
+        if(i->getHandle() > max) max = i->getHandle();
+        RTI::ULong h = this->searchMaxHandle(i->getSubEntities());
+        if(h > max) max = h ;
     }
-    return false ;
+    return max ;
 }
 
 // ---------------------------------------------------------------------------
@@ -449,9 +960,32 @@ Federation::objectExists(RTI::ObjectHandle handle)
 RTI::ObjectHandle 
 Federation::getObjectTranslation(int n, RTI::ObjectHandle object)
 {
-    for(vector<Obj>::iterator i=dobj.begin(); i!=dobj.end(); i++) {
-        if(i->getHandle()==object) return i->getTranslation(n);     
-    }
+    RTI::ObjectHandle* row = dobj.findRow(object);
+    if(row && n>=0 && n<(int) peers.size()) return row[n] ;
+    return 0 ;
+}
+
+// ---------------------------------------------------------------------------
+// getObjectTranslations : surrogates of an object, indexed by peer, or NULL
+// if the object is unknown
+// 
+RTI::ObjectHandle* 
+Federation::getObjectTranslations(RTI::ObjectHandle object)
+{
+    return dobj.findRow(object);
+}
+
+// ---------------------------------------------------------------------------
+// getObjectTranslations : same, also returning the class of the object
+// 
+RTI::ObjectHandle* 
+Federation::getObjectTranslations(RTI::ObjectHandle object, 
+                                  RTI::ObjectClassHandle &class_handle)
+{
+    int slot = dobj.find(object);
+    if(slot < 0) return NULL ;
+    class_handle = dobj.getClass(slot);
+    return dobj.getRow(slot);
 }
 
 // ---------------------------------------------------------------------------
@@ -460,22 +994,70 @@ Federation::getObjectTranslation(int n, RTI::ObjectHandle object)
 RTI::ObjectClassHandle 
 Federation::getObjectClassTranslation(int n, RTI::ObjectClassHandle object)
 {
-    return this->searchObjectClassTranslation(sobj, n, object);
+    CanonicalId id = objMap.getClass(object);
+    if(id == 0 || n < 0 || n >= (int) peers.size() || peers[n] == NULL) 
+        return 0 ;
+    return peers[n]->objMap.getLocalClass(id);
 }
 
 // ---------------------------------------------------------------------------
-// searchObjectClassTranslation
-//
-RTI::ObjectClassHandle
-Federation::searchObjectClassTranslation(vector<ObjClass> &v, int n, 
-                                         RTI::ObjectClassHandle object)
+// getAttributeTranslation
+// 
+RTI::AttributeHandle
+Federation::getAttributeTranslation(int n, RTI::ObjectClassHandle object, 
+                                    RTI::AttributeHandle attribute)
 {
-    for(vector<ObjClass>::iterator i=v.begin(); i!=v.end(); i++) {
-        if(i->getHandle()==object) return i->getTranslation(n);
-        else return this->searchObjectClassTranslation(i->getSubEntities(), 
-                                                       n, object);
+    RTI::ObjectClassHandle c = this->getObjectClassTranslation(n, object);
+    if(c == 0) return 0 ;
+    Federation* peer = peers[n] ;
+    RTI::AttributeHandle a = 
+        peer->objMap.getLocalMember(objMap.getMember(object, attribute));
+    if(a && !peer->publications.allowsAttribute(c, a)) return 0 ;
+    return a ;
+}
+
+// ---------------------------------------------------------------------------
+// translateAttributes : add the attributes of an object of a class, as
+// known by peer n, to a set
+// 
+void
+Federation::translateAttributes(int n, RTI::ObjectClassHandle object,
+                                const RTI::AttributeHandleValuePairSet& in,
+                                RTI::AttributeHandleValuePairSet& out)
+{
+    RTI::ObjectClassHandle c = this->getObjectClassTranslation(n, object);
+    const vector<CanonicalId>* ids = objMap.getMembers(object);
+    if(c == 0 || ids == NULL) return ;
+    Federation* peer = peers[n] ;
+    bool restricted = peer->publications.restrictsClasses();
+
+    RTI::ULong size = in.size();
+    for(RTI::ULong k=0; k<size; k++) {
+        RTI::AttributeHandle h = in.getHandle(k);
+        if(h >= ids->size() || (*ids)[h] == 0) continue ;
+        RTI::AttributeHandle a = peer->objMap.getLocalMember((*ids)[h]);
+        if(a == 0 || (restricted && !peer->publications.allowsAttribute(c, a)))
+            continue ;
+        RTI::ULong length ;
+        char* value = in.getValuePointer(k, length);
+        out.add(a, value, length);
     }
-    return 0 ;
+}
+
+// ---------------------------------------------------------------------------
+// isAttributeIdentity : true if the attributes of a class keep the same
+// handles in peer n, that is when both classes have the same layout and no
+// attribute is left out
+// 
+bool
+Federation::isAttributeIdentity(int n, RTI::ObjectClassHandle object)
+{
+    RTI::ObjectClassHandle c = this->getObjectClassTranslation(n, object);
+    if(c == 0) return false ;
+    Federation* peer = peers[n] ;
+    if(subscriptions.restrictsClasses() || peer->publications.restrictsClasses())
+        return false ;
+    return objMap.getLayout(object) == peer->objMap.getLayout(c);
 }
 
 // ---------------------------------------------------------------------------
@@ -485,11 +1067,64 @@ RTI::InteractionClassHandle
 Federation::getInteractionClassTranslation(int n, 
                                            RTI::InteractionClassHandle interaction)
 {
-    for(vector<IntClass>::iterator i=sint.begin(); i!=sint.end(); i++) {
-        if(i->getHandle()==interaction) return i->getTranslation(n);     
+    CanonicalId id = intMap.getClass(interaction);
+    if(id == 0 || n < 0 || n >= (int) peers.size() || peers[n] == NULL) 
+        return 0 ;
+    return peers[n]->intMap.getLocalClass(id);
+}
+
+// ---------------------------------------------------------------------------
+// getParameterTranslation
+// 
+RTI::ParameterHandle
+Federation::getParameterTranslation(int n, 
+                                    RTI::InteractionClassHandle interaction, 
+                                    RTI::ParameterHandle parameter)
+{
+    if(this->getInteractionClassTranslation(n, interaction) == 0) return 0 ;
+    return peers[n]->intMap.getLocalMember(intMap.getMember(interaction, 
+                                                            parameter));
+}
+
+// ---------------------------------------------------------------------------
+// translateParameters : add the parameters of an interaction, as known by
+// peer n, to a set
+// 
+void
+Federation::translateParameters(int n, RTI::InteractionClassHandle interaction,
+                                const RTI::ParameterHandleValuePairSet& in,
+                                RTI::ParameterHandleValuePairSet& out)
+{
+    const vector<CanonicalId>* ids = intMap.getMembers(interaction);
+    if(ids == NULL || this->getInteractionClassTranslation(n, interaction) == 0)
+        return ;
+    Federation* peer = peers[n] ;
+
+    RTI::ULong size = in.size();
+    for(RTI::ULong k=0; k<size; k++) {
+        RTI::ParameterHandle h = in.getHandle(k);
+        if(h >= ids->size() || (*ids)[h] == 0) continue ;
+        RTI::ParameterHandle p = peer->intMap.getLocalMember((*ids)[h]);
+        if(p == 0) continue ;
+        RTI::ULong length ;
+        char* value = in.getValuePointer(k, length);
+        out.add(p, value, length);
     }
 }
 
+// ---------------------------------------------------------------------------
+// isParameterIdentity : true if the parameters of an interaction class keep
+// the same handles in peer n
+// 
+bool
+Federation::isParameterIdentity(int n, RTI::InteractionClassHandle interaction)
+{
+    RTI::InteractionClassHandle c = 
+        this->getInteractionClassTranslation(n, interaction);
+    if(c == 0) return false ;
+    return intMap.getLayout(interaction) == peers[n]->intMap.getLayout(c);
+}
+
 // ---------------------------------------------------------------------------
 // setId
 //
@@ -514,8 +1149,8 @@ Federation::empty(void)
 void
 Federation::resign(RTI::FedTime &t)
 {
-    for(vector<Obj>::iterator i=dobj.begin(); i!=dobj.end(); i++) {
-        rtiamb->deleteObjectInstance(i->getHandle(), t, "");
+    for(int i=0; i<dobj.capacity(); i++) {
+        if(dobj.getHandle(i)) rtiamb->deleteObjectInstance(dobj.getHandle(i), t, "");
     }    
 }
 
@@ -529,119 +1164,237 @@ Federation::setVerbose(bool v)
 }
 
 // ----------------------------------------------------------------------------
-//! Main method to parse .xml file
+//! Main method to parse the FOM, a .fed file or an .xml file
 int
 Federation::parse(string filename)
 {
-    doc = xmlParseFile(filename.c_str());
+    size_t n = filename.size();
+    bool fed = n > 4 && !strcasecmp(filename.c_str() + n - 4, ".fed") ;
+    int r = fed ? this->parseFed(filename) : this->parseXml(filename);
+
+    objIndex.clear();
+    intIndex.clear();
+    this->index(sobj, NULL, objIndex);
+    this->index(sint, NULL, intIndex);
+    return r ;
+}
 
-    // Did libXML manage to parse the file ?
-    if (doc == 0) {
+// ----------------------------------------------------------------------------
+//! Parse an .xml file. The file is streamed : classes are added to their
+//! parent, on top of a stack of the open class elements, in a single pass
+//! over the file.
+int
+Federation::parseXml(string filename)
+{
+    xmlTextReaderPtr reader = xmlReaderForFile(filename.c_str(), NULL, 0);
+    if (reader == NULL) {
         cerr << "XML file not parsed successfully" << endl ;
-        xmlFreeDoc(doc);
         return 1 ;
     }
 
-    // Is there a root element ?
-    cur = xmlDocGetRootElement(doc);
-    if (cur == 0) {
-        cerr << "XML file is empty" << endl ;
-        xmlFreeDoc(doc);
-        return 1 ;
-    }
+    vector<ObjClass*> classes ;      // open objectClass elements
+    vector<IntClass*> interactions ; // open interactionClass elements
+    Space* space = NULL ;            // open routingSpace element
+    bool root = true ;
+    int r ;
+    while ((r = xmlTextReaderRead(reader)) == 1) {
+        int type = xmlTextReaderNodeType(reader);
+        const xmlChar* node = xmlTextReaderConstLocalName(reader);
 
-    // Is this root element an objectModel ?
-    if (xmlStrcmp(cur->name, (const xmlChar *) NODE_OBJECT_MODEL)) {
-        cerr << "Wrong XML file: not the expected root node" << endl ;
-        return 1 ;
-    }
-    if (verbose)
-        cout << "XML file looks ok, starting main loop" << endl ;
-
-    // Loop
-    cur = xmlDocGetRootElement(doc);
-    cur = cur->xmlChildrenNode ;
-    while (cur != NULL) {
-        if ((!xmlStrcmp(cur->name, NODE_OBJECTS))) {
-            xmlNodePtr prev = cur ;
-            cur = cur->xmlChildrenNode ;
-            while (cur != NULL) {
-                if ((!xmlStrcmp(cur->name, NODE_OBJECT_CLASS))) {
-                    this->parseClass("");
-                }
-                cur = cur->next ;
-            }
-            cur = prev ;
-        }
-        if ((!xmlStrcmp(cur->name, NODE_INTERACTIONS))) {
-            xmlNodePtr prev = cur ;
-            cur = cur->xmlChildrenNode ;
-            while (cur != NULL) {
-                if ((!xmlStrcmp(cur->name, NODE_INTERACTION_CLASS))) {
-                    this->parseInteraction("");
-                }
-                cur = cur->next ;
+        if (type == XML_READER_TYPE_END_ELEMENT) {
+            if (!xmlStrcmp(node, NODE_OBJECT_CLASS) && !classes.empty())
+                classes.pop_back();
+            else if (!xmlStrcmp(node, NODE_INTERACTION_CLASS) && 
+                     !interactions.empty())
+                interactions.pop_back();
+            else if (!xmlStrcmp(node, NODE_ROUTING_SPACE))
+                space = NULL ;
+            continue ;
+        }
+        if (type != XML_READER_TYPE_ELEMENT) continue ;
+        bool open = !xmlTextReaderIsEmptyElement(reader);
+
+        // Is this root element an objectModel ?
+        if (root) {
+            if (xmlStrcmp(node, NODE_OBJECT_MODEL)) {
+                cerr << "Wrong XML file: not the expected root node" << endl ;
+                xmlFreeTextReader(reader);
+                return 1 ;
             }
-            cur = prev ;
+            if (verbose)
+                cout << "XML file looks ok, starting main loop" << endl ;
+            root = false ;
+        }
+        // Classes, added to the class on top of the stack. Elements are
+        // only pushed while their children are read : a class is never
+        // moved by the addition of a sibling while it is on the stack.
+        else if (!xmlStrcmp(node, NODE_OBJECT_CLASS)) {
+            vector<ObjClass> &v = 
+                classes.empty() ? sobj : classes.back()->getSubEntities();
+            v.push_back(ObjClass(GetXmlProp(reader, ATTRIBUTE_NAME)));
+            if (open) classes.push_back(&v.back());
+        }
+        else if (!xmlStrcmp(node, NODE_ATTRIBUTE) && !classes.empty()) {
+            ObjClass* c = classes.back();
+            c->addAttribute(GetXmlProp(reader, ATTRIBUTE_NAME));
+            Attr &a = c->getAttributes().back();
+            a.setSpace(GetXmlProp(reader, ATTRIBUTE_SPACE));
+            SetDelivery(a, reader);
+        }
+        else if (!xmlStrcmp(node, NODE_INTERACTION_CLASS)) {
+            vector<IntClass> &v = interactions.empty() ? 
+                sint : interactions.back()->getSubEntities();
+            v.push_back(IntClass(GetXmlProp(reader, ATTRIBUTE_NAME)));
+            v.back().setSpace(GetXmlProp(reader, ATTRIBUTE_SPACE));
+            SetDelivery(v.back(), reader);
+            if (open) interactions.push_back(&v.back());
         }
-        cur = cur->next ;
+        else if (!xmlStrcmp(node, NODE_PARAMETER) && !interactions.empty()) {
+            interactions.back()->addAttribute(GetXmlProp(reader, ATTRIBUTE_NAME));
+        }
+        // Routing spaces, with their dimensions (possibly grouped)
+        else if (!xmlStrcmp(node, NODE_ROUTING_SPACE)) {
+            spaces.push_back(Space(GetXmlProp(reader, ATTRIBUTE_NAME)));
+            if (open) space = &spaces.back();
+        }
+        else if (!xmlStrcmp(node, NODE_DIMENSION) && space) {
+            space->addAttribute(GetXmlProp(reader, ATTRIBUTE_NAME));
+        }
+    }
+    xmlFreeTextReader(reader);
+    if (r < 0 || root) {
+        cerr << "XML file not parsed successfully" << endl ;
+        return 1 ;
     }
-    xmlFreeDoc(doc);
+    return 0 ;
 }
 
 // ----------------------------------------------------------------------------
-//! Parse the current class node
+//! Index a class tree by name, once it is complete
 void
-Federation::parseClass(string parent)
+Federation::index(vector<ObjClass> &v, ObjClass* parent, ClassIndex &index)
 {
-    xmlNodePtr prev = cur ;
-    const char *current = (char *) xmlGetProp(cur, ATTRIBUTE_NAME);
-
-    if (parent == "")
-        sobj.push_back(ObjClass(current));
-    else
-        this->addSubObjectClass(parent, current);
-
-    cur = cur->xmlChildrenNode ;
-    while (cur != NULL) {
-        // Attributes
-        if ((!xmlStrcmp(cur->name, NODE_ATTRIBUTE))) {
-            this->addAttribute(sobj, current,
-                               (char *) xmlGetProp(cur, ATTRIBUTE_NAME));
-        }
-        // Subclasses
-        if ((!xmlStrcmp(cur->name, NODE_OBJECT_CLASS))) {
-            this->parseClass(current);
-        }
-        cur = cur->next ;
+    for(vector<ObjClass>::iterator i=v.begin(); i!=v.end(); i++) {
+        index.insert(make_pair(i->getName(), make_pair(&*i, parent)));
+        this->index(i->getSubEntities(), &*i, index);
     }
-    cur = prev ;
 }
 
 // ----------------------------------------------------------------------------
-//! Parse the current interaction node
-void
-Federation::parseInteraction(string parent)
+//! Parse a .fed file, in a single pass over its text. Lists are handled
+//! on a stack : classes are added to the class of the enclosing list, as
+//! in parseXml. Lists the bridge does not need (federate, sec_level...)
+//! are skipped.
+int
+Federation::parseFed(string filename)
 {
-    xmlNodePtr prev = cur ;
-    const char *current = (char *) xmlGetProp(cur, ATTRIBUTE_NAME);
+    ifstream in(filename.c_str(), ios::in | ios::binary);
+    if (!in) {
+        cerr << "FED file " << filename << " not found" << endl ;
+        return 1 ;
+    }
+    string text((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+
+    enum List { SKIP, FED, OBJECTS, INTERACTIONS, SPACES, 
+                OBJECT_CLASS, ATTRIBUTE, INTERACTION_CLASS, PARAMETER, SPACE };
+    struct Open {
+        List list ;
+        void* entity ; // ObjClass, Attr, IntClass, Param or Space
+    };
+    vector<Open> stack ;
+    FedLexer lexer(text.data(), text.size());
+    FedLexer::Token t ;
 
-    if (parent == "")
-        sint.push_back(IntClass(current));
-    else
-        this->addSubInteractionClass(parent, current);
+    while ((t = lexer.next()) != FedLexer::END) {
+        if (t == FedLexer::CLOSE) {
+            if (stack.empty()) break ;
+            stack.pop_back();
+            continue ;
+        }
+        List parent = stack.empty() ? SKIP : stack.back().list ;
+        void* entity = stack.empty() ? NULL : stack.back().entity ;
+
+        // Atoms after the name of an attribute or interaction class
+        if (t == FedLexer::ATOM) {
+            if (parent == ATTRIBUTE) 
+                SetDelivery(*(Attr*) entity, lexer);
+            else if (parent == INTERACTION_CLASS) 
+                SetDelivery(*(IntClass*) entity, lexer);
+            continue ;
+        }
 
-    cur = cur->xmlChildrenNode ;
-    while (cur != NULL) {
-        if ((!xmlStrcmp(cur->name, NODE_PARAMETER))) {
-            this->addParameter(current,
-                               (char *) xmlGetProp(cur, ATTRIBUTE_NAME));
+        // A list : its keyword, then its name for the named ones
+        if (lexer.next() != FedLexer::ATOM) break ;
+        Open o = { SKIP, NULL } ;
+        bool named = true ;
+        if (stack.empty() && lexer.is("fed")) {
+            o.list = FED ;
+            named = false ;
         }
-        // Subinteraction
-        if ((!xmlStrcmp(cur->name, NODE_INTERACTION_CLASS))) {
-            this->parseInteraction(current);
+        else if (parent == FED) {
+            named = false ;
+            if (lexer.is("objects")) o.list = OBJECTS ;
+            else if (lexer.is("interactions")) o.list = INTERACTIONS ;
+            else if (lexer.is("spaces")) o.list = SPACES ;
         }
-        cur = cur->next ;
+        else if (lexer.is("class") && 
+                 (parent == OBJECTS || parent == OBJECT_CLASS)) {
+            o.list = OBJECT_CLASS ;
+        }
+        else if (lexer.is("class") && 
+                 (parent == INTERACTIONS || parent == INTERACTION_CLASS)) {
+            o.list = INTERACTION_CLASS ;
+        }
+        else if (lexer.is("attribute") && parent == OBJECT_CLASS)
+            o.list = ATTRIBUTE ;
+        else if (lexer.is("parameter") && parent == INTERACTION_CLASS)
+            o.list = PARAMETER ;
+        else if (lexer.is("space") && parent == SPACES)
+            o.list = SPACE ;
+        else if (lexer.is("dimension") && parent == SPACE)
+            o.list = SKIP ; // named, added below
+        else named = false ;
+
+        if (named) {
+            if (lexer.next() != FedLexer::ATOM) break ;
+            string name = lexer.atom();
+            switch (o.list) {
+              case OBJECT_CLASS: {
+                  vector<ObjClass> &v = parent == OBJECTS ? 
+                      sobj : ((ObjClass*) entity)->getSubEntities();
+                  v.push_back(ObjClass(name));
+                  o.entity = &v.back();
+                  break ;
+              }
+              case ATTRIBUTE:
+                  ((ObjClass*) entity)->addAttribute(name);
+                  o.entity = &((ObjClass*) entity)->getAttributes().back();
+                  break ;
+              case INTERACTION_CLASS: {
+                  vector<IntClass> &v = parent == INTERACTIONS ? 
+                      sint : ((IntClass*) entity)->getSubEntities();
+                  v.push_back(IntClass(name));
+                  o.entity = &v.back();
+                  break ;
+              }
+              case PARAMETER:
+                  ((IntClass*) entity)->addAttribute(name);
+                  break ;
+              case SPACE:
+                  spaces.push_back(Space(name));
+                  o.entity = &spaces.back();
+                  break ;
+              default: // dimension
+                  ((Space*) entity)->addAttribute(name);
+            }
+        }
+        stack.push_back(o);
     }
-    cur = prev ;
+
+    if (t != FedLexer::END || !stack.empty()) {
+        cerr << "FED file " << filename << ": syntax error line " 
+             << lexer.line << endl ;
+        return 1 ;
+    }
+    return 0 ;
 }
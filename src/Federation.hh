@@ -19,12 +19,18 @@
 
 #include <config.h>
 #include <vector>
+#include <map>
+#include <unordered_map>
 #include <RTI.hh>
 #include "Entity.hh"
 #include "ContainerEntity.hh"
+#include "ObjectTable.hh"
+#include "CanonicalMap.hh"
+#include "AllowList.hh"
 
 #include <libxml/xmlmemory.h>
 #include <libxml/parser.h>
+#include <libxml/xmlreader.h>
 
 using namespace std ;
 
@@ -53,8 +59,25 @@ typedef Entity<RTI::AttributeHandle> Attr ;
 typedef Entity<RTI::ParameterHandle> Param ;
 typedef ContainerEntity<RTI::ObjectClassHandle, Attr> ObjClass ;
 typedef ContainerEntity<RTI::InteractionClassHandle, Param> IntClass ;
+typedef Entity<RTI::DimensionHandle> Dim ;
+typedef ContainerEntity<RTI::SpaceHandle, Dim> Space ;
+
+// Range of a subscription region along one dimension of a routing space ;
+// an extent holds one range per constrained dimension
+struct RegionBound {
+    string dimension ;
+    RTI::ULong lower ;
+    RTI::ULong upper ;
+};
+typedef vector<RegionBound> RegionExtent ;
+
+typedef CanonicalMap<RTI::ObjectClassHandle, RTI::AttributeHandle> ObjMap ;
+typedef CanonicalMap<RTI::InteractionClassHandle, RTI::ParameterHandle> IntMap ;
+
+// Classes (or interaction classes) by name, with their parent class (NULL
+// for the roots) ; built once the class tree is complete
+typedef unordered_map<string, pair<ObjClass*, ObjClass*> > ClassIndex ;
 
-typedef Entity<RTI::ObjectHandle> Obj ;
 
 class Federation 
 {
@@ -65,71 +88,124 @@ public:
     void setVerbose(bool);
 
     void update();
-    void connect(Federation&);
+    void setModel(CanonicalModel*);
+    int connect(Federation&);
+    void disconnect(int);
     void setId(int);
     void resign(RTI::FedTime &);
   
     RTI::ObjectClassHandle getObjectClassHandle(string);
     RTI::AttributeHandle getAttributeHandle(string);
+    RTI::AttributeHandle getAttributeHandle(string, string);
     RTI::InteractionClassHandle getInteractionClassHandle(string);
     RTI::ParameterHandle getParameterHandle(string);
+    RTI::ParameterHandle getParameterHandle(string, string);
 
     void publishAll(void);
     void subscribeAll(void);
+    void addRegionExtent(string, const RegionExtent&);
+    void deleteRegions(void);
+    AllowList& getPublications(void);
+    AllowList& getSubscriptions(void);
 
-    void discoverObject(RTI::ObjectHandle, string);
+    void discoverObject(RTI::ObjectHandle, RTI::ObjectClassHandle, string);
     void removeObject(RTI::ObjectHandle);
 
-    void addObjectTranslation(RTI::ObjectHandle, RTI::ObjectHandle);
+    void setObjectTranslation(int, RTI::ObjectHandle, RTI::ObjectHandle);
     RTI::ObjectHandle getObjectTranslation(int, RTI::ObjectHandle);
+    RTI::ObjectHandle* getObjectTranslations(RTI::ObjectHandle);
+    RTI::ObjectHandle* getObjectTranslations(RTI::ObjectHandle, 
+                                             RTI::ObjectClassHandle&);
     RTI::ObjectClassHandle getObjectClassTranslation(int, RTI::ObjectClassHandle);
+    RTI::AttributeHandle getAttributeTranslation(int, RTI::ObjectClassHandle,
+                                                 RTI::AttributeHandle);
+    void translateAttributes(int, RTI::ObjectClassHandle,
+                             const RTI::AttributeHandleValuePairSet&,
+                             RTI::AttributeHandleValuePairSet&);
+    bool isAttributeIdentity(int, RTI::ObjectClassHandle);
     RTI::InteractionClassHandle getInteractionClassTranslation(int, RTI::InteractionClassHandle);
+    RTI::ParameterHandle getParameterTranslation(int, RTI::InteractionClassHandle,
+                                                 RTI::ParameterHandle);
+    void translateParameters(int, RTI::InteractionClassHandle,
+                             const RTI::ParameterHandleValuePairSet&,
+                             RTI::ParameterHandleValuePairSet&);
+    bool isParameterIdentity(int, RTI::InteractionClassHandle);
 
     bool objectExists(RTI::ObjectHandle);
+    void getSurrogates(int, vector<RTI::ObjectHandle>&);
+    string getObjectName(RTI::ObjectHandle);
+
+    RTI::ObjectClassHandle getMaxObjectClassHandle(void);
+    RTI::InteractionClassHandle getMaxInteractionClassHandle(void);
+    vector<ObjClass>& getObjectClasses(void);
+    vector<IntClass>& getInteractionClasses(void);
 
     bool empty(void);
 
 private:
     void updateObjectClasses(vector<ObjClass>&);
     void updateInteractionClasses(vector<IntClass>&);
-    void addAttribute(vector<ObjClass>&, string, string);
-    void addSubObjectClass(string, string);
-    void addSubInteractionClass(string, string);
-    void addParameter(string, string);
-    RTI::ObjectClassHandle searchObjectClassHandle(vector<ObjClass>&, string&);
-    RTI::InteractionClassHandle searchInteractionClassHandle(vector<ObjClass>&, 
-                                                        string&);
     RTI::AttributeHandle searchAttributeHandle(vector<ObjClass>&, string&);
     RTI::ParameterHandle searchParameterHandle(vector<IntClass>&, string&);
+    RTI::ULong searchMemberHandle(ClassIndex&, string&, string&);
+    RTI::ULong searchClassHandle(ClassIndex&, string&);
+
+    RTI::ULong searchMaxHandle(vector<ObjClass>&);
+    void index(vector<ObjClass>&, ObjClass*, ClassIndex&);
 
-    RTI::ObjectClassHandle searchObjectClassTranslation(vector<IntClass>&, int, 
-                                                   RTI::ObjectClassHandle);
+    void updateSpaces(void);
+    void createRegions(void);
+    Space* findSpace(string);
+    RTI::Region* findRegion(string);
 
-    void connectObjectClasses(vector<ObjClass>&, Federation&);
-    void connectInteractionClasses(vector<IntClass>&, Federation&);
+    void compile(void);
+    void compileObjectClasses(vector<ObjClass>&, 
+                              vector<pair<string, Attr*> >&);
+    void compileInteractionClasses(vector<IntClass>&, 
+                                   vector<pair<string, Param*> >&);
+    void resolve(void);
 
-    void publishAllObjectClasses(vector<ObjClass>&);
+    void publishAllObjectClasses(vector<ObjClass>&, vector<Attr*>&);
     void publishAllInteractionClasses(vector<IntClass>&);
-    void subscribeAllObjectClasses(vector<ObjClass>&);
+    void subscribeAllObjectClasses(vector<ObjClass>&, vector<Attr*>&);
     void subscribeAllInteractionClasses(vector<IntClass>&);
 
     void dump(void);
 
     int parse(string);
-    void parseClass(string);
-    void parseInteraction(string);
+    int parseXml(string);
+    int parseFed(string);
 
     RTI::RTIambassador* rtiamb ;
     vector<ObjClass> sobj ;
     vector<IntClass> sint ;
-    vector<Obj> dobj ;
+    ClassIndex objIndex ;
+    ClassIndex intIndex ;
+    vector<Space> spaces ;
+    ObjectTable dobj ;
+
+    // Subscription regions : extents given by the configuration, and the
+    // regions created from them, by routing space name
+    map<string, vector<RegionExtent> > extents ;
+    map<string, RTI::Region*> regions ;
+    // Subscriptions made with them, undone by deleteRegions
+    vector<pair<RTI::ObjectClassHandle, RTI::Region*> > regionClasses ;
+    vector<pair<RTI::InteractionClassHandle, RTI::Region*> > regionInteractions ;
+
+    // What is published to, and subscribed from, this federation ; compiled
+    // by update()
+    AllowList publications ;
+    AllowList subscriptions ;
+
+    // Translations to and from the canonical model, compiled by update()
+    // and resolve()
+    CanonicalModel* model ;
+    ObjMap objMap ;
+    IntMap intMap ;
+    vector<Federation*> peers ; // by translation index, NULL once removed
 
-    int translations ;
     int id ;
     bool verbose ;
-
-    xmlDocPtr doc ;
-    xmlNodePtr cur ;
 };
 
 #endif // FEDERATION_HH
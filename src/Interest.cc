@@ -0,0 +1,97 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "Interest.hh"
+#include <cstddef>
+
+// ---------------------------------------------------------------------------
+// Interest
+// 
+Interest::Interest()
+{
+    objectClasses = NULL ;
+    objectClassCount = 0 ;
+    interactions = NULL ;
+    interactionCount = 0 ;
+}
+
+// ---------------------------------------------------------------------------
+// ~Interest
+// 
+Interest::~Interest()
+{
+    delete[] objectClasses ;
+    delete[] interactions ;
+}
+
+// ---------------------------------------------------------------------------
+// resize : track handles below the given counts, all set to initial. Not
+// thread safe, must be called before other threads read the flags.
+// 
+void
+Interest::resize(unsigned long classes, unsigned long ints, bool initial)
+{
+    delete[] objectClasses ;
+    delete[] interactions ;
+    objectClasses = new atomic<bool>[classes] ;
+    interactions = new atomic<bool>[ints] ;
+    objectClassCount = classes ;
+    interactionCount = ints ;
+    for (unsigned long i = 0 ; i < classes ; i++) objectClasses[i] = initial ;
+    for (unsigned long i = 0 ; i < ints ; i++) interactions[i] = initial ;
+}
+
+// ---------------------------------------------------------------------------
+// setObjectClass
+// 
+void
+Interest::setObjectClass(RTI::ObjectClassHandle h, bool b)
+{
+    if (h < objectClassCount) {
+        objectClasses[h].store(b, memory_order_relaxed);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// hasObjectClass
+// 
+bool
+Interest::hasObjectClass(RTI::ObjectClassHandle h)
+{
+    if (h >= objectClassCount) return true ;
+    return objectClasses[h].load(memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// setInteraction
+// 
+void
+Interest::setInteraction(RTI::InteractionClassHandle h, bool b)
+{
+    if (h < interactionCount) {
+        interactions[h].store(b, memory_order_relaxed);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// hasInteraction
+// 
+bool
+Interest::hasInteraction(RTI::InteractionClassHandle h)
+{
+    if (h >= interactionCount) return true ;
+    return interactions[h].load(memory_order_relaxed);
+}
@@ -0,0 +1,50 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef INTEREST_HH
+#define INTEREST_HH
+
+#include <config.h>
+#include <atomic>
+#include <RTI.hh>
+
+using namespace std ;
+
+// Object classes and interactions that have subscribers in a federation, as
+// told by the relevance advisories of the RTI. Flags are written by the
+// federate receiving the advisories and may be read by other threads.
+// Handles beyond the sizes given to resize() are always interesting.
+class Interest
+{
+public:
+    Interest();
+    ~Interest();
+
+    void resize(unsigned long, unsigned long, bool);
+
+    void setObjectClass(RTI::ObjectClassHandle, bool);
+    bool hasObjectClass(RTI::ObjectClassHandle);
+    void setInteraction(RTI::InteractionClassHandle, bool);
+    bool hasInteraction(RTI::InteractionClassHandle);
+
+private:
+    atomic<bool>* objectClasses ;
+    unsigned long objectClassCount ;
+    atomic<bool>* interactions ;
+    unsigned long interactionCount ;
+};
+
+#endif // INTEREST_HH
@@ -0,0 +1,73 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "LbtsBoard.hh"
+
+#include <iostream>
+#include <new>
+#include <stdlib.h>
+
+// ---------------------------------------------------------------------------
+// LbtsBoard : n slots, for federate ids 0 to n-1. new does not honour the
+// alignment of Slot before C++17, the slots are allocated on a line boundary.
+// 
+LbtsBoard::LbtsBoard(int n_)
+{
+    n = n_ ;
+    if (posix_memalign((void **) &slots, LBTS_BOARD_LINE, n * sizeof(Slot))) {
+        cerr << "LbtsBoard: out of memory" << endl ;
+        exit(-1);
+    }
+    for (int i = 0 ; i < n ; i++) new (&slots[i]) Slot ;
+    for (int i = 0 ; i < n ; i++) slots[i].lbts.store(0.0);
+}
+
+// ---------------------------------------------------------------------------
+// ~LbtsBoard
+// 
+LbtsBoard::~LbtsBoard()
+{
+    for (int i = 0 ; i < n ; i++) slots[i].~Slot();
+    free(slots);
+}
+
+// ---------------------------------------------------------------------------
+// size
+// 
+int
+LbtsBoard::size(void)
+{
+    return n ;
+}
+
+// ---------------------------------------------------------------------------
+// post : publish the LBTS of federate i
+// 
+void
+LbtsBoard::post(int i, double lbts)
+{
+    if (i >= 0 && i < n) slots[i].lbts.store(lbts, memory_order_release);
+}
+
+// ---------------------------------------------------------------------------
+// get : last LBTS published by federate i
+// 
+double
+LbtsBoard::get(int i)
+{
+    if (i < 0 || i >= n) return 0.0 ;
+    return slots[i].lbts.load(memory_order_acquire);
+}
@@ -0,0 +1,53 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef LBTS_BOARD_HH
+#define LBTS_BOARD_HH
+
+#include <atomic>
+
+using namespace std ;
+
+#define LBTS_BOARD_LINE 64
+
+// Board where every bridge federate posts the LBTS of its federation once
+// per cycle. Peers read it from memory instead of querying the RTI of each
+// other federation. Slots are indexed by federate id ; each one sits on its
+// own cache line so that posts from different threads do not interfere.
+class LbtsBoard
+{
+public:
+    LbtsBoard(int);
+    ~LbtsBoard();
+
+    // The board owns its slots
+    LbtsBoard(const LbtsBoard&) = delete ;
+    LbtsBoard& operator=(const LbtsBoard&) = delete ;
+
+    int size(void);
+    void post(int, double);
+    double get(int);
+
+private:
+    struct alignas(LBTS_BOARD_LINE) Slot {
+        atomic<double> lbts ;
+    };
+
+    Slot* slots ;
+    int n ;
+};
+
+#endif // LBTS_BOARD_HH
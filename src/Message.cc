@@ -0,0 +1,102 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "Message.hh"
+
+// ---------------------------------------------------------------------------
+// Message
+// 
+Message::Message()
+{
+    type = UPDATE ;
+    origin = -1 ;
+    object = 0 ;
+    surrogate = 0 ;
+    handle = 0 ;
+    time = 0.0 ;
+}
+
+// ---------------------------------------------------------------------------
+// ~Message
+// 
+Message::~Message()
+{
+}
+
+// ---------------------------------------------------------------------------
+// clear : empty the message, keeping the buffers
+// 
+void
+Message::clear(void)
+{
+    object = 0 ;
+    surrogate = 0 ;
+    handle = 0 ;
+    name.clear();
+    handles.clear();
+    offsets.clear();
+    values.clear();
+}
+
+// ---------------------------------------------------------------------------
+// add : append a (handle, value) pair
+// 
+void
+Message::add(RTI::ULong h, const char* value, RTI::ULong length)
+{
+    handles.push_back(h);
+    offsets.push_back(values.size());
+    values.insert(values.end(), value, value + length);
+}
+
+// ---------------------------------------------------------------------------
+// getValue : value of the i-th pair
+// 
+const char*
+Message::getValue(size_t i, RTI::ULong &length)
+{
+    size_t end = i + 1 < handles.size() ? offsets[i + 1] : values.size();
+    length = end - offsets[i] ;
+    return length ? &values[offsets[i]] : "" ;
+}
+
+// ---------------------------------------------------------------------------
+// fill : copy the pairs into an attribute set
+// 
+void
+Message::fill(RTI::AttributeHandleValuePairSet &set)
+{
+    RTI::ULong length ;
+    set.empty();
+    for (size_t i = 0 ; i < handles.size() ; i++) {
+        const char* value = this->getValue(i, length);
+        set.add(handles[i], value, length);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// fill : copy the pairs into a parameter set
+// 
+void
+Message::fill(RTI::ParameterHandleValuePairSet &set)
+{
+    RTI::ULong length ;
+    set.empty();
+    for (size_t i = 0 ; i < handles.size() ; i++) {
+        const char* value = this->getValue(i, length);
+        set.add(handles[i], value, length);
+    }
+}
@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef MESSAGE_HH
+#define MESSAGE_HH
+
+#include <config.h>
+#include <string>
+#include <vector>
+#include <RTI.hh>
+
+using namespace std ;
+
+// An operation forwarded from a source federate to a peer through a
+// Channel. The message owns a copy of the values ; its buffers keep their
+// capacity when the channel slot is reused.
+class Message
+{
+public:
+    enum Type { DISCOVER, UPDATE, INTERACTION, REMOVE };
+
+    Message();
+    ~Message();
+
+    void clear(void);
+    void add(RTI::ULong, const char*, RTI::ULong);
+    const char* getValue(size_t, RTI::ULong&);
+    void fill(RTI::AttributeHandleValuePairSet&);
+    void fill(RTI::ParameterHandleValuePairSet&);
+
+    Type type ;
+    int origin ;                   // id of the source federate
+    RTI::ObjectHandle object ;     // object handle in the source federation
+    RTI::ObjectHandle surrogate ;  // surrogate handle, 0 if unknown yet
+    RTI::ULong handle ;            // object or interaction class, translated
+    double time ;
+    string name ;                  // DISCOVER only
+
+    vector<RTI::ULong> handles ;   // attribute or parameter handles
+    vector<RTI::ULong> offsets ;   // offset of each value in values
+    vector<char> values ;
+};
+
+#endif // MESSAGE_HH
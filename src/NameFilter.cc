@@ -0,0 +1,385 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "NameFilter.hh"
+#include <iostream>
+#include <map>
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+// NameFilter
+// 
+NameFilter::NameFilter()
+{
+    includes = false ;
+    excludes = false ;
+    compiled = false ;
+    start = this->node();
+}
+
+// ---------------------------------------------------------------------------
+// ~NameFilter
+// 
+NameFilter::~NameFilter()
+{
+}
+
+// ---------------------------------------------------------------------------
+// node : new NFA node
+// 
+int
+NameFilter::node(void)
+{
+    Node n ;
+    n.set = -1 ;
+    n.next = -1 ;
+    n.accept = 0 ;
+    nodes.push_back(n);
+    return nodes.size() - 1 ;
+}
+
+// ---------------------------------------------------------------------------
+// charSet : new set of characters
+// 
+int
+NameFilter::charSet(const bitset<256> &b)
+{
+    sets.push_back(b);
+    return sets.size() - 1 ;
+}
+
+// ---------------------------------------------------------------------------
+// globToRegex : regular expression of a glob, or of a prefix
+// 
+string
+NameFilter::globToRegex(const string &g, bool prefix)
+{
+    const string special = "\\.|*+?()[]" ;
+    string r ;
+    for (size_t i = 0 ; i < g.size() ; i++) {
+        char c = g[i] ;
+        if (!prefix && c == '*') r += ".*" ;
+        else if (!prefix && c == '?') r += "." ;
+        else if (!prefix && c == '[') {
+            size_t j = g.find(']', i + 2);
+            if (j == string::npos) {
+                r += "\\[" ;
+                continue ;
+            }
+            r += '[' ;
+            i++ ;
+            if (g[i] == '!') {
+                r += '^' ;
+                i++ ;
+            }
+            for ( ; i < j ; i++) {
+                if (g[i] == '\\') r += '\\' ;
+                r += g[i] ;
+            }
+            r += ']' ;
+        }
+        else {
+            if (special.find(c) != string::npos) r += '\\' ;
+            r += c ;
+        }
+    }
+    if (prefix) r += ".*" ;
+    return r ;
+}
+
+// ---------------------------------------------------------------------------
+// add : include (true) or exclude pattern. Returns false if the pattern is
+// not valid ; it is then ignored.
+// 
+bool
+NameFilter::add(bool include, Kind kind, string pattern)
+{
+    string regex = (kind == REGEX) ? pattern : 
+        globToRegex(pattern, kind == PREFIX) ;
+
+    size_t i = 0 ;
+    Fragment f ;
+    size_t mark = nodes.size(), marks = sets.size() ;
+    if (!this->parseAlt(regex, i, f) || i != regex.size()) {
+        cout << "Warning: invalid name pattern " << pattern << endl ;
+        nodes.resize(mark);
+        sets.resize(marks);
+        return false ;
+    }
+    nodes[f.end].accept |= include ? INCLUDE : EXCLUDE ;
+    nodes[start].eps.push_back(f.start);
+    if (include) includes = true ;
+    else excludes = true ;
+    compiled = false ;
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// parseAlt : a|b|...
+// 
+bool
+NameFilter::parseAlt(const string &r, size_t &i, Fragment &f)
+{
+    if (!this->parseConcat(r, i, f)) return false ;
+    while (i < r.size() && r[i] == '|') {
+        i++ ;
+        Fragment g ;
+        if (!this->parseConcat(r, i, g)) return false ;
+        int s = this->node(), e = this->node();
+        nodes[s].eps.push_back(f.start);
+        nodes[s].eps.push_back(g.start);
+        nodes[f.end].eps.push_back(e);
+        nodes[g.end].eps.push_back(e);
+        f.start = s ;
+        f.end = e ;
+    }
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// parseConcat : sequence of repeated atoms, possibly empty
+// 
+bool
+NameFilter::parseConcat(const string &r, size_t &i, Fragment &f)
+{
+    f.start = f.end = this->node();
+    while (i < r.size() && r[i] != '|' && r[i] != ')') {
+        Fragment g ;
+        if (!this->parseRepeat(r, i, g)) return false ;
+        nodes[f.end].eps.push_back(g.start);
+        f.end = g.end ;
+    }
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// parseRepeat : atom followed by * + or ?
+// 
+bool
+NameFilter::parseRepeat(const string &r, size_t &i, Fragment &f)
+{
+    if (!this->parseAtom(r, i, f)) return false ;
+    while (i < r.size() && (r[i] == '*' || r[i] == '+' || r[i] == '?')) {
+        int s = this->node(), e = this->node();
+        if (r[i] != '+') nodes[s].eps.push_back(e);           // may skip
+        if (r[i] != '?') nodes[f.end].eps.push_back(f.start); // may repeat
+        nodes[s].eps.push_back(f.start);
+        nodes[f.end].eps.push_back(e);
+        f.start = s ;
+        f.end = e ;
+        i++ ;
+    }
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// parseAtom : character, class, . or (alternative)
+// 
+bool
+NameFilter::parseAtom(const string &r, size_t &i, Fragment &f)
+{
+    bitset<256> b ;
+    char c = r[i] ;
+    if (c == '(') {
+        i++ ;
+        if (!this->parseAlt(r, i, f)) return false ;
+        if (i >= r.size() || r[i] != ')') return false ;
+        i++ ;
+        return true ;
+    }
+    if (c == '*' || c == '+' || c == '?' || c == ']') return false ;
+    if (c == '[') {
+        i++ ;
+        if (!this->parseClass(r, i, b)) return false ;
+    }
+    else if (c == '.') {
+        b.set();
+        i++ ;
+    }
+    else if (c == '\\') {
+        if (i + 1 >= r.size()) return false ;
+        b.set((unsigned char) r[i + 1]);
+        i += 2 ;
+    }
+    else {
+        b.set((unsigned char) c);
+        i++ ;
+    }
+    f.start = this->node();
+    f.end = this->node();
+    nodes[f.start].set = this->charSet(b);
+    nodes[f.start].next = f.end ;
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// parseClass : [abc] [a-z] [^...], after the opening bracket
+// 
+bool
+NameFilter::parseClass(const string &r, size_t &i, bitset<256> &b)
+{
+    bool negate = false ;
+    if (i < r.size() && r[i] == '^') {
+        negate = true ;
+        i++ ;
+    }
+    bool first = true ;
+    while (i < r.size() && (r[i] != ']' || first)) {
+        first = false ;
+        unsigned char lo = r[i] ;
+        if (lo == '\\' && i + 1 < r.size()) lo = r[++i] ;
+        unsigned char hi = lo ;
+        if (i + 2 < r.size() && r[i + 1] == '-' && r[i + 2] != ']') {
+            hi = r[i + 2] ;
+            i += 2 ;
+        }
+        for (int c = lo ; c <= hi ; c++) b.set(c);
+        i++ ;
+    }
+    if (i >= r.size()) return false ;
+    i++ ; // ]
+    if (negate) b.flip();
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// closure : add the nodes reachable by epsilon moves, and sort
+// 
+void
+NameFilter::closure(vector<int> &v)
+{
+    vector<bool> seen(nodes.size(), false);
+    vector<int> stack(v);
+    v.clear();
+    while (!stack.empty()) {
+        int n = stack.back();
+        stack.pop_back();
+        if (seen[n]) continue ;
+        seen[n] = true ;
+        v.push_back(n);
+        for (size_t k = 0 ; k < nodes[n].eps.size() ; k++) {
+            stack.push_back(nodes[n].eps[k]);
+        }
+    }
+    sort(v.begin(), v.end());
+}
+
+// ---------------------------------------------------------------------------
+// compile : build the DFA by subset construction. Returns false if it gets
+// too large ; names are then run through the NFA.
+// 
+bool
+NameFilter::compile(void)
+{
+    table.clear();
+    flags.clear();
+    compiled = false ;
+    if (!this->enabled()) return true ;
+
+    map<vector<int>, int> ids ;
+    vector<vector<int> > states ;
+    vector<int> s(1, start);
+    this->closure(s);
+    ids[s] = 0 ;
+    states.push_back(s);
+
+    for (size_t d = 0 ; d < states.size() ; d++) {
+        int f = 0 ;
+        for (size_t k = 0 ; k < states[d].size() ; k++) {
+            f |= nodes[states[d][k]].accept ;
+        }
+        flags.push_back(f);
+        table.resize((d + 1) * 256, 0);
+
+        for (int c = 0 ; c < 256 ; c++) {
+            vector<int> m ;
+            for (size_t k = 0 ; k < states[d].size() ; k++) {
+                const Node &n = nodes[states[d][k]] ;
+                if (n.set >= 0 && sets[n.set].test(c)) m.push_back(n.next);
+            }
+            this->closure(m);
+            map<vector<int>, int>::iterator i = ids.find(m);
+            if (i == ids.end()) {
+                if (states.size() >= NAME_FILTER_MAX_STATES) {
+                    cout << "Warning: name filter too complex for a DFA, "
+                         << "names checked by NFA simulation" << endl ;
+                    table.clear();
+                    flags.clear();
+                    return false ;
+                }
+                i = ids.insert(make_pair(m, (int) states.size())).first ;
+                states.push_back(m);
+            }
+            table[d * 256 + c] = i->second ;
+        }
+    }
+    compiled = true ;
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// enabled : true if there is any pattern
+// 
+bool
+NameFilter::enabled(void)
+{
+    return includes || excludes ;
+}
+
+// ---------------------------------------------------------------------------
+// simulate : run a name through the NFA, returns the accept flags of the
+// nodes reached
+// 
+int
+NameFilter::simulate(const string &name)
+{
+    vector<int> s(1, start);
+    this->closure(s);
+    for (size_t k = 0 ; k < name.size() && !s.empty() ; k++) {
+        unsigned char c = name[k] ;
+        vector<int> m ;
+        for (size_t j = 0 ; j < s.size() ; j++) {
+            const Node &n = nodes[s[j]] ;
+            if (n.set >= 0 && sets[n.set].test(c)) m.push_back(n.next);
+        }
+        this->closure(m);
+        s.swap(m);
+    }
+    int f = 0 ;
+    for (size_t j = 0 ; j < s.size() ; j++) f |= nodes[s[j]].accept ;
+    return f ;
+}
+
+// ---------------------------------------------------------------------------
+// accepts : run a name through the DFA, or the NFA if it could not be
+// compiled
+// 
+bool
+NameFilter::accepts(const string &name)
+{
+    if (!this->enabled()) return true ;
+    int f ;
+    if (compiled) {
+        int s = 0 ;
+        for (size_t k = 0 ; k < name.size() ; k++) {
+            s = table[s * 256 + (unsigned char) name[k]] ;
+        }
+        f = flags[s] ;
+    }
+    else f = this->simulate(name);
+    if (f & EXCLUDE) return false ;
+    return !includes || (f & INCLUDE) ;
+}
@@ -0,0 +1,86 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef NAME_FILTER_HH
+#define NAME_FILTER_HH
+
+#include <config.h>
+#include <string>
+#include <vector>
+#include <bitset>
+
+using namespace std ;
+
+#define NAME_FILTER_MAX_STATES 4096
+
+// Include and exclude patterns on object names. Prefixes, globs (* ? [...])
+// and regular expressions (| * + ? ( ) . [...] and \ escapes, matching the
+// whole name) are compiled together into one DFA, so that a name is
+// checked in a single pass. A name is accepted if it matches no exclude
+// pattern and, when there are include patterns, one of them. Patterns whose
+// DFA would be too large are run as an NFA instead, never ignored.
+class NameFilter
+{
+public:
+    enum Kind { PREFIX, GLOB, REGEX };
+
+    NameFilter();
+    ~NameFilter();
+
+    bool add(bool, Kind, string);
+    bool compile(void);
+    bool enabled(void);
+
+    bool accepts(const string&);
+
+private:
+    // NFA, built by Thompson's construction
+    struct Node {
+        int set ;  // index in sets of the characters leading to next, or -1
+        int next ;
+        vector<int> eps ;
+        int accept ; // 0, INCLUDE or EXCLUDE
+    };
+    struct Fragment {
+        int start ;
+        int end ;
+    };
+    enum { INCLUDE = 1, EXCLUDE = 2 };
+
+    static string globToRegex(const string&, bool);
+    int node(void);
+    int charSet(const bitset<256>&);
+    bool parseAlt(const string&, size_t&, Fragment&);
+    bool parseConcat(const string&, size_t&, Fragment&);
+    bool parseRepeat(const string&, size_t&, Fragment&);
+    bool parseAtom(const string&, size_t&, Fragment&);
+    bool parseClass(const string&, size_t&, bitset<256>&);
+    void closure(vector<int>&);
+    int simulate(const string&);
+
+    vector<Node> nodes ;
+    vector<bitset<256> > sets ;
+    int start ;
+    bool includes ;
+    bool excludes ;
+
+    // DFA : table[state * 256 + c], flags[state]
+    vector<int> table ;
+    vector<int> flags ;
+    bool compiled ;
+};
+
+#endif // NAME_FILTER_HH
@@ -0,0 +1,274 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "ObjectTable.hh"
+
+#include <iostream>
+#include <stdlib.h>
+#include <string.h>
+
+#define OBJECT_TABLE_ALIGN 64
+#define OBJECT_TABLE_MIN_SLOTS 64
+
+// ---------------------------------------------------------------------------
+// ObjectTable
+// 
+ObjectTable::ObjectTable()
+{
+    rows = NULL ;
+    slots = 0 ;
+    peers = 0 ;
+    stride = 1 ;
+}
+
+// ---------------------------------------------------------------------------
+// ~ObjectTable
+// 
+ObjectTable::~ObjectTable()
+{
+    free(rows);
+}
+
+// ---------------------------------------------------------------------------
+// setPeers : set the number of surrogates per object. Rows are padded to a
+// power of two (up to a cache line) so that a row never spans two lines.
+// 
+void
+ObjectTable::setPeers(int n)
+{
+    int s = 1 ;
+    int line = OBJECT_TABLE_ALIGN / sizeof(RTI::ObjectHandle) ;
+
+    while (s < n && s < line) s *= 2 ;
+    if (n > line) s = ((n + line - 1) / line) * line ;
+
+    peers = n ;
+    if (s != stride) this->restride(s);
+}
+
+// ---------------------------------------------------------------------------
+// getPeers
+// 
+int
+ObjectTable::getPeers(void)
+{
+    return peers ;
+}
+
+// ---------------------------------------------------------------------------
+// clearPeer : forget the surrogates of every object in peer n
+// 
+void
+ObjectTable::clearPeer(int n)
+{
+    if (n < 0 || n >= peers) return ;
+    for (int i = 0 ; i < slots ; i++) rows[(size_t) i * stride + n] = 0 ;
+}
+
+// ---------------------------------------------------------------------------
+// restride : change the row width, keeping the existing surrogates
+// 
+void
+ObjectTable::restride(int s)
+{
+    RTI::ObjectHandle* r = NULL ;
+
+    if (slots > 0) {
+        if (posix_memalign((void **) &r, OBJECT_TABLE_ALIGN,
+                           (size_t) slots * s * sizeof(RTI::ObjectHandle))) {
+            cerr << "ObjectTable: out of memory" << endl ;
+            exit(-1);
+        }
+        memset(r, 0, (size_t) slots * s * sizeof(RTI::ObjectHandle));
+        int w = s < stride ? s : stride ;
+        for (int i = 0 ; i < slots ; i++)
+            memcpy(r + (size_t) i * s, rows + (size_t) i * stride,
+                   w * sizeof(RTI::ObjectHandle));
+    }
+    free(rows);
+    rows = r ;
+    stride = s ;
+}
+
+// ---------------------------------------------------------------------------
+// reserve : grow the slot arrays
+// 
+void
+ObjectTable::reserve(int n)
+{
+    if (n <= slots) return ;
+
+    RTI::ObjectHandle* r = NULL ;
+    if (posix_memalign((void **) &r, OBJECT_TABLE_ALIGN,
+                       (size_t) n * stride * sizeof(RTI::ObjectHandle))) {
+        cerr << "ObjectTable: out of memory" << endl ;
+        exit(-1);
+    }
+    if (slots > 0)
+        memcpy(r, rows, (size_t) slots * stride * sizeof(RTI::ObjectHandle));
+    memset(r + (size_t) slots * stride, 0,
+           (size_t) (n - slots) * stride * sizeof(RTI::ObjectHandle));
+    free(rows);
+    rows = r ;
+
+    handles.resize(n, 0);
+    classes.resize(n, 0);
+    names.resize(n);
+    for (int i = n - 1 ; i >= slots ; i--) freeSlots.push_back(i);
+    slots = n ;
+}
+
+// ---------------------------------------------------------------------------
+// insert : returns the slot of the new object, -1 if already known
+// 
+int
+ObjectTable::insert(RTI::ObjectHandle h, RTI::ObjectClassHandle c, string name)
+{
+    if (index.find(h) != index.end()) return -1 ;
+
+    if (freeSlots.empty())
+        this->reserve(slots > 0 ? 2 * slots : OBJECT_TABLE_MIN_SLOTS);
+
+    int slot = freeSlots.back();
+    freeSlots.pop_back();
+
+    index[h] = slot ;
+    handles[slot] = h ;
+    classes[slot] = c ;
+    names[slot] = name ;
+    memset(rows + (size_t) slot * stride, 0, stride * sizeof(RTI::ObjectHandle));
+
+    return slot ;
+}
+
+// ---------------------------------------------------------------------------
+// erase
+// 
+bool
+ObjectTable::erase(RTI::ObjectHandle h)
+{
+    unordered_map<RTI::ObjectHandle, int>::iterator i = index.find(h);
+    if (i == index.end()) return false ;
+
+    int slot = i->second ;
+    index.erase(i);
+    handles[slot] = 0 ;
+    classes[slot] = 0 ;
+    names[slot].clear();
+    freeSlots.push_back(slot);
+
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// clear
+// 
+void
+ObjectTable::clear(void)
+{
+    index.clear();
+    freeSlots.clear();
+    for (int i = slots - 1 ; i >= 0 ; i--) {
+        handles[i] = 0 ;
+        classes[i] = 0 ;
+        names[i].clear();
+        freeSlots.push_back(i);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// find : slot of an object, -1 if unknown
+// 
+int
+ObjectTable::find(RTI::ObjectHandle h)
+{
+    unordered_map<RTI::ObjectHandle, int>::iterator i = index.find(h);
+    return i == index.end() ? -1 : i->second ;
+}
+
+// ---------------------------------------------------------------------------
+// exists
+// 
+bool
+ObjectTable::exists(RTI::ObjectHandle h)
+{
+    return index.find(h) != index.end() ;
+}
+
+// ---------------------------------------------------------------------------
+// size : number of objects
+// 
+int
+ObjectTable::size(void)
+{
+    return index.size();
+}
+
+// ---------------------------------------------------------------------------
+// capacity : number of slots, used or free
+// 
+int
+ObjectTable::capacity(void)
+{
+    return slots ;
+}
+
+// ---------------------------------------------------------------------------
+// getHandle : object in a slot, 0 if the slot is free
+// 
+RTI::ObjectHandle
+ObjectTable::getHandle(int slot)
+{
+    return handles[slot] ;
+}
+
+// ---------------------------------------------------------------------------
+// getClass
+// 
+RTI::ObjectClassHandle
+ObjectTable::getClass(int slot)
+{
+    return classes[slot] ;
+}
+
+// ---------------------------------------------------------------------------
+// getName
+// 
+const string&
+ObjectTable::getName(int slot)
+{
+    return names[slot] ;
+}
+
+// ---------------------------------------------------------------------------
+// getRow : surrogates of a slot, indexed by peer
+// 
+RTI::ObjectHandle*
+ObjectTable::getRow(int slot)
+{
+    return rows + (size_t) slot * stride ;
+}
+
+// ---------------------------------------------------------------------------
+// findRow : surrogates of an object, NULL if unknown
+// 
+RTI::ObjectHandle*
+ObjectTable::findRow(RTI::ObjectHandle h)
+{
+    unordered_map<RTI::ObjectHandle, int>::iterator i = index.find(h);
+    if (i == index.end()) return NULL ;
+    return rows + (size_t) i->second * stride ;
+}
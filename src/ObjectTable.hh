@@ -0,0 +1,79 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef OBJECT_TABLE_HH
+#define OBJECT_TABLE_HH
+
+#include <config.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <RTI.hh>
+
+using namespace std ;
+
+// Discovered objects of a federation, stored as a structure of arrays.
+// Each object gets a slot ; the surrogates registered in the peer
+// federations are kept in one contiguous row per slot, indexed by peer, so
+// that forwarding an update touches a single cache line. Names are only
+// needed at registration time and are kept apart from the hot data.
+class ObjectTable
+{
+public:
+    ObjectTable();
+    ~ObjectTable();
+
+    // The table owns its rows
+    ObjectTable(const ObjectTable&) = delete ;
+    ObjectTable& operator=(const ObjectTable&) = delete ;
+
+    void setPeers(int);
+    int getPeers(void);
+    void clearPeer(int);
+
+    int insert(RTI::ObjectHandle, RTI::ObjectClassHandle, string);
+    bool erase(RTI::ObjectHandle);
+    void clear(void);
+
+    int find(RTI::ObjectHandle);
+    bool exists(RTI::ObjectHandle);
+    int size(void);
+    int capacity(void);
+
+    RTI::ObjectHandle getHandle(int);
+    RTI::ObjectClassHandle getClass(int);
+    const string& getName(int);
+
+    RTI::ObjectHandle* getRow(int);
+    RTI::ObjectHandle* findRow(RTI::ObjectHandle);
+
+private:
+    void reserve(int);
+    void restride(int);
+
+    unordered_map<RTI::ObjectHandle, int> index ;
+    vector<RTI::ObjectHandle> handles ; // slot -> object, 0 if free
+    vector<RTI::ObjectClassHandle> classes ;
+    vector<string> names ;
+    vector<int> freeSlots ;
+
+    RTI::ObjectHandle* rows ; // slots * stride surrogates, cache aligned
+    int slots ;
+    int peers ;
+    int stride ;
+};
+
+#endif // OBJECT_TABLE_HH
@@ -0,0 +1,155 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "PositionTracker.hh"
+#include "Federation.hh"
+#include <iostream>
+
+// ---------------------------------------------------------------------------
+// PositionTracker
+// 
+PositionTracker::PositionTracker()
+{
+}
+
+// ---------------------------------------------------------------------------
+// ~PositionTracker
+// 
+PositionTracker::~PositionTracker()
+{
+}
+
+// ---------------------------------------------------------------------------
+// addClass : class name, names of the x and y attributes, their encoding
+// 
+void
+PositionTracker::addClass(string name, string x, string y, 
+                          DeadReckoning::Encoding e)
+{
+    Spec s ;
+    s.name = name ;
+    s.xName = x ;
+    s.yName = y ;
+    s.handle = 0 ;
+    s.x = s.y = 0 ;
+    s.encoding = e ;
+    specs.push_back(s);
+}
+
+// ---------------------------------------------------------------------------
+// compile : resolve the names, once the federation joined. Unknown classes
+// or attributes are reported and ignored.
+// 
+void
+PositionTracker::compile(Federation &f)
+{
+    vector<Spec>::iterator i = specs.begin();
+    while (i != specs.end()) {
+        i->handle = f.getObjectClassHandle(i->name);
+        i->x = f.getAttributeHandle(i->name, i->xName);
+        i->y = f.getAttributeHandle(i->name, i->yName);
+        if (i->handle == 0 || i->x == 0 || i->y == 0) {
+            cout << "Warning: unknown position " << i->name << "(" 
+                 << i->xName << ", " << i->yName << ")" << endl ;
+            i = specs.erase(i);
+        }
+        else i++ ;
+    }
+    positions.clear();
+}
+
+// ---------------------------------------------------------------------------
+// enabled
+// 
+bool
+PositionTracker::enabled(void)
+{
+    return !specs.empty();
+}
+
+// ---------------------------------------------------------------------------
+// findClass : index of the spec of a class, -1 if none
+// 
+int
+PositionTracker::findClass(RTI::ObjectClassHandle h)
+{
+    for (size_t i = 0 ; i < specs.size() ; i++) {
+        if (specs[i].handle == h) return i ;
+    }
+    return -1 ;
+}
+
+// ---------------------------------------------------------------------------
+// tracks : true if objects of a class have a position
+// 
+bool
+PositionTracker::tracks(RTI::ObjectClassHandle h)
+{
+    return this->findClass(h) >= 0 ;
+}
+
+// ---------------------------------------------------------------------------
+// locate : update the position of an object from an update, and return it.
+// False if the class has no position, or the object no known position yet.
+// 
+bool
+PositionTracker::locate(RTI::ObjectHandle object, RTI::ObjectClassHandle c,
+                        const RTI::AttributeHandleValuePairSet &in,
+                        double &x, double &y)
+{
+    int s = this->findClass(c);
+    if (s < 0) return false ;
+    Spec &spec = specs[s] ;
+
+    unordered_map<RTI::ObjectHandle, Position>::iterator i = 
+        positions.find(object);
+    if (i == positions.end()) {
+        Position p = { false, false, 0.0, 0.0 } ;
+        i = positions.insert(make_pair(object, p)).first ;
+    }
+    Position &p = i->second ;
+
+    RTI::ULong n = in.size();
+    for (RTI::ULong k = 0 ; k < n ; k++) {
+        RTI::AttributeHandle h = in.getHandle(k);
+        if (h != spec.x && h != spec.y) continue ;
+        RTI::ULong length ;
+        const char* value = in.getValuePointer(k, length);
+        double v ;
+        if (!DeadReckoning::decode(spec.encoding, value, length, v)) continue ;
+        if (h == spec.x) {
+            p.x = v ;
+            p.hasX = true ;
+        }
+        else {
+            p.y = v ;
+            p.hasY = true ;
+        }
+    }
+    if (!p.hasX || !p.hasY) return false ;
+    x = p.x ;
+    y = p.y ;
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// erase : forget an object
+// 
+void
+PositionTracker::erase(RTI::ObjectHandle object)
+{
+    positions.erase(object);
+}
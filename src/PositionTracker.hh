@@ -0,0 +1,66 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef POSITION_TRACKER_HH
+#define POSITION_TRACKER_HH
+
+#include <config.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <RTI.hh>
+#include "DeadReckoning.hh"
+
+class Federation ;
+
+using namespace std ;
+
+// Last known positions of the objects reflected by a federation, decoded
+// from the configured position attributes of their class
+class PositionTracker
+{
+public:
+    PositionTracker();
+    ~PositionTracker();
+
+    void addClass(string, string, string, DeadReckoning::Encoding);
+    void compile(Federation&);
+    bool enabled(void);
+    bool tracks(RTI::ObjectClassHandle);
+
+    bool locate(RTI::ObjectHandle, RTI::ObjectClassHandle,
+                const RTI::AttributeHandleValuePairSet&, double&, double&);
+    void erase(RTI::ObjectHandle);
+
+private:
+    struct Spec {
+        string name, xName, yName ;
+        RTI::ObjectClassHandle handle ;
+        RTI::AttributeHandle x, y ;
+        DeadReckoning::Encoding encoding ;
+    };
+    struct Position {
+        bool hasX, hasY ;
+        double x, y ;
+    };
+
+    int findClass(RTI::ObjectClassHandle);
+
+    vector<Spec> specs ;
+    unordered_map<RTI::ObjectHandle, Position> positions ;
+};
+
+#endif // POSITION_TRACKER_HH
@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "RoutingTable.hh"
+#include "Federation.hh"
+#include <iostream>
+
+// ---------------------------------------------------------------------------
+// RoutingTable
+// 
+RoutingTable::RoutingTable()
+{
+}
+
+// ---------------------------------------------------------------------------
+// ~RoutingTable
+// 
+RoutingTable::~RoutingTable()
+{
+}
+
+// ---------------------------------------------------------------------------
+// addRoute : destination federation, object class and interaction class
+// (both may be empty)
+// 
+void
+RoutingTable::addRoute(string destination, string c, string i)
+{
+    Route r ;
+    r.destination = destination ;
+    r.objectClass = c ;
+    r.interactionClass = i ;
+    r.peer = -1 ;
+    r.objectHandle = 0 ;
+    r.interactionHandle = 0 ;
+    specs.push_back(r);
+}
+
+// ---------------------------------------------------------------------------
+// enabled : true if some route is given
+// 
+bool
+RoutingTable::enabled(void)
+{
+    return !specs.empty();
+}
+
+// ---------------------------------------------------------------------------
+// routes : true if class c (an object class if object, an interaction
+// class otherwise) goes to peer t
+// 
+bool
+RoutingTable::routes(int t, RTI::ULong c, bool object)
+{
+    if (specs.empty()) return true ;
+    for (vector<Route>::iterator r = specs.begin() ; r != specs.end() ; r++) {
+        if (r->peer != t) continue ;
+        if (r->objectClass.empty() && r->interactionClass.empty()) return true ;
+        if (object && r->objectHandle == c) return true ;
+        if (!object && r->interactionHandle == c) return true ;
+    }
+    return false ;
+}
+
+// ---------------------------------------------------------------------------
+// compile : build the destination lists, once the federation is connected
+// to its peers (given by federation name, in translation order)
+// 
+void
+RoutingTable::compile(Federation &f, const vector<string> &names)
+{
+    objects.clear();
+    interactions.clear();
+
+    for (vector<Route>::iterator r = specs.begin() ; r != specs.end() ; r++) {
+        r->peer = -1 ;
+        for (size_t t = 0 ; t < names.size() ; t++) {
+            if (names[t] == r->destination) r->peer = t ;
+        }
+        if (r->peer < 0) {
+            cout << "Warning: route to unknown federation " << r->destination 
+                 << endl ;
+        }
+        if (!r->objectClass.empty()) {
+            r->objectHandle = f.getObjectClassHandle(r->objectClass);
+            if (r->objectHandle == 0) {
+                cout << "Warning: route of unknown class " << r->objectClass 
+                     << endl ;
+            }
+        }
+        if (!r->interactionClass.empty()) {
+            r->interactionHandle = 
+                f.getInteractionClassHandle(r->interactionClass);
+            if (r->interactionHandle == 0) {
+                cout << "Warning: route of unknown interaction " 
+                     << r->interactionClass << endl ;
+            }
+        }
+    }
+
+    objects.resize(f.getMaxObjectClassHandle() + 1);
+    for (RTI::ObjectClassHandle c = 1 ; c < objects.size() ; c++) {
+        for (size_t t = 0 ; t < names.size() ; t++) {
+            if (f.getObjectClassTranslation(t, c) == 0) continue ;
+            if (this->routes(t, c, true)) objects[c].push_back(t);
+        }
+    }
+
+    interactions.resize(f.getMaxInteractionClassHandle() + 1);
+    for (RTI::InteractionClassHandle c = 1 ; c < interactions.size() ; c++) {
+        for (size_t t = 0 ; t < names.size() ; t++) {
+            if (f.getInteractionClassTranslation(t, c) == 0) continue ;
+            if (this->routes(t, c, false)) interactions[c].push_back(t);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// getObjectDestinations : peers receiving the objects of a class
+// 
+const vector<int>&
+RoutingTable::getObjectDestinations(RTI::ObjectClassHandle c)
+{
+    return c < objects.size() ? objects[c] : none ;
+}
+
+// ---------------------------------------------------------------------------
+// getInteractionDestinations : peers receiving an interaction class
+// 
+const vector<int>&
+RoutingTable::getInteractionDestinations(RTI::InteractionClassHandle c)
+{
+    return c < interactions.size() ? interactions[c] : none ;
+}
@@ -0,0 +1,70 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef ROUTING_TABLE_HH
+#define ROUTING_TABLE_HH
+
+#include <config.h>
+#include <string>
+#include <vector>
+#include <RTI.hh>
+
+class Federation ;
+
+using namespace std ;
+
+// Destinations of what a federation reflects. Routes given by the
+// configuration name a destination federation and, optionally, an object
+// class or an interaction class (exact names). Without any route, every
+// peer is a destination. Routes are compiled into lists of peer indexes
+// by class handle ; peers that have no translation for a class are left
+// out of its list.
+class RoutingTable
+{
+public:
+    RoutingTable();
+    ~RoutingTable();
+
+    void addRoute(string, string, string);
+    bool enabled(void);
+
+    void compile(Federation&, const vector<string>&);
+
+    const vector<int>& getObjectDestinations(RTI::ObjectClassHandle);
+    const vector<int>& getInteractionDestinations(RTI::InteractionClassHandle);
+
+private:
+    struct Route {
+        string destination ;
+        string objectClass ;      // empty : any
+        string interactionClass ; // empty : any
+        // Compiled
+        int peer ;
+        RTI::ObjectClassHandle objectHandle ;
+        RTI::InteractionClassHandle interactionHandle ;
+    };
+
+    bool routes(int, RTI::ULong, bool);
+
+    vector<Route> specs ;
+
+    // Compiled, by class handle
+    vector<vector<int> > objects ;
+    vector<vector<int> > interactions ;
+    vector<int> none ;
+};
+
+#endif // ROUTING_TABLE_HH
@@ -0,0 +1,207 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "SpatialGrid.hh"
+#include <iostream>
+#include <math.h>
+
+// ---------------------------------------------------------------------------
+// SpatialGrid
+// 
+SpatialGrid::SpatialGrid()
+{
+    cell = 1.0 ;
+    xmin = ymin = 0.0 ;
+    nx = ny = 0 ;
+    everywhere = ~0ULL ;
+}
+
+// ---------------------------------------------------------------------------
+// ~SpatialGrid
+// 
+SpatialGrid::~SpatialGrid()
+{
+}
+
+// ---------------------------------------------------------------------------
+// setCell : size of the grid cells, may be enlarged by build()
+// 
+void
+SpatialGrid::setCell(double c)
+{
+    if (c > 0.0) cell = c ;
+}
+
+// ---------------------------------------------------------------------------
+// addArea : area of interest of a federate (it may have several)
+// 
+void
+SpatialGrid::addArea(int id, double x0, double y0, double x1, double y1)
+{
+    if (id < 0 || id >= SPATIAL_GRID_MAX_FEDERATES) {
+        cout << "Warning: area of interest ignored for federate " << id 
+             << endl ;
+        return ;
+    }
+    Area a ;
+    a.id = id ;
+    a.xmin = fmin(x0, x1) ;
+    a.ymin = fmin(y0, y1) ;
+    a.xmax = fmax(x0, x1) ;
+    a.ymax = fmax(y0, y1) ;
+    areas.push_back(a);
+}
+
+// ---------------------------------------------------------------------------
+// removeAreas : forget the areas of a federate, whose id may be given to
+// another one ; build must be called again
+// 
+void
+SpatialGrid::removeAreas(int id)
+{
+    vector<Area>::iterator a = areas.begin();
+    while (a != areas.end()) {
+        if (a->id == id) a = areas.erase(a);
+        else a++ ;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// build : compute the cells, once all the areas are known
+// 
+void
+SpatialGrid::build(int federates)
+{
+    everywhere = ~0ULL ;
+    full.clear();
+    partial.clear();
+    first.clear();
+    cellAreas.clear();
+    nx = ny = 0 ;
+    if (areas.empty()) return ;
+
+    for (vector<Area>::iterator a=areas.begin(); a!=areas.end(); a++) {
+        everywhere &= ~(1ULL << a->id) ;
+    }
+
+    double xmax = areas[0].xmax, ymax = areas[0].ymax ;
+    xmin = areas[0].xmin ;
+    ymin = areas[0].ymin ;
+    for (vector<Area>::iterator a=areas.begin(); a!=areas.end(); a++) {
+        xmin = fmin(xmin, a->xmin) ;
+        ymin = fmin(ymin, a->ymin) ;
+        xmax = fmax(xmax, a->xmax) ;
+        ymax = fmax(ymax, a->ymax) ;
+    }
+    double w = fmax(xmax - xmin, cell) ;
+    double h = fmax(ymax - ymin, cell) ;
+    if ((w / cell) * (h / cell) > SPATIAL_GRID_MAX_CELLS) {
+        cell = sqrt(w * h / SPATIAL_GRID_MAX_CELLS) * 1.01 ;
+        cout << "Warning: grid cells enlarged to " << cell << endl ;
+    }
+    nx = (int) ceil(w / cell) ;
+    ny = (int) ceil(h / cell) ;
+    full.assign(nx * ny, 0ULL);
+    partial.assign(nx * ny, 0ULL);
+    first.assign(nx * ny + 1, 0);
+    vector<pair<int, int> > covers ; // (cell, area) covered partly
+
+    for (vector<Area>::iterator a=areas.begin(); a!=areas.end(); a++) {
+        Mask bit = 1ULL << a->id ;
+        int i0 = (int) floor((a->xmin - xmin) / cell) ;
+        int j0 = (int) floor((a->ymin - ymin) / cell) ;
+        int i1 = (int) floor((a->xmax - xmin) / cell) ;
+        int j1 = (int) floor((a->ymax - ymin) / cell) ;
+        if (i1 >= nx) i1 = nx - 1 ;
+        if (j1 >= ny) j1 = ny - 1 ;
+        for (int j = j0 ; j <= j1 ; j++) {
+            for (int i = i0 ; i <= i1 ; i++) {
+                double cx0 = xmin + i * cell, cy0 = ymin + j * cell ;
+                if (cx0 >= a->xmin && cx0 + cell <= a->xmax &&
+                    cy0 >= a->ymin && cy0 + cell <= a->ymax) {
+                    full[j * nx + i] |= bit ;
+                }
+                else {
+                    partial[j * nx + i] |= bit ;
+                    covers.push_back(make_pair(j * nx + i, a - areas.begin()));
+                }
+            }
+        }
+    }
+
+    // Group the partial areas by cell
+    for (size_t k = 0 ; k < covers.size() ; k++) first[covers[k].first + 1]++ ;
+    for (int c = 0 ; c < nx * ny ; c++) first[c + 1] += first[c] ;
+    cellAreas.resize(covers.size());
+    vector<int> next(first.begin(), first.end() - 1);
+    for (size_t k = 0 ; k < covers.size() ; k++) 
+        cellAreas[next[covers[k].first]++] = covers[k].second ;
+    cout << "Spatial grid : " << nx << "x" << ny << " cells of " << cell 
+         << " for " << areas.size() << " areas, " << federates 
+         << " federates" << endl ;
+}
+
+// ---------------------------------------------------------------------------
+// enabled : true if some federate has an area of interest
+// 
+bool
+SpatialGrid::enabled(void)
+{
+    return !areas.empty();
+}
+
+// ---------------------------------------------------------------------------
+// restricts : true if federate id is only interested in its areas
+// 
+bool
+SpatialGrid::restricts(int id)
+{
+    if (id < 0 || id >= SPATIAL_GRID_MAX_FEDERATES) return false ;
+    return !(everywhere & (1ULL << id)) ;
+}
+
+// ---------------------------------------------------------------------------
+// lookup : federates interested in a position. Only the areas that cover
+// the cell of the position partly are tested, and only for the federates
+// not already known to be interested.
+// 
+SpatialGrid::Mask
+SpatialGrid::lookup(double x, double y)
+{
+    if (nx == 0) return everywhere ;
+
+    double fx = (x - xmin) / cell, fy = (y - ymin) / cell ;
+    if (!(fx >= 0.0 && fy >= 0.0 && fx <= nx && fy <= ny)) { // NaN too
+        return everywhere ;
+    }
+    int i = (int) fx, j = (int) fy ;
+    if (i == nx) i-- ;
+    if (j == ny) j-- ;
+
+    int c = j * nx + i ;
+    Mask m = everywhere | full[c] ;
+    Mask p = partial[c] & ~m ;
+    for (int k = first[c] ; p && k < first[c + 1] ; k++) {
+        const Area &a = areas[cellAreas[k]] ;
+        Mask bit = 1ULL << a.id ;
+        if ((p & bit) && x >= a.xmin && x <= a.xmax && 
+            y >= a.ymin && y <= a.ymax) {
+            m |= bit ;
+            p &= ~bit ;
+        }
+    }
+    return m ;
+}
@@ -0,0 +1,71 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef SPATIAL_GRID_HH
+#define SPATIAL_GRID_HH
+
+#include <config.h>
+#include <vector>
+
+using namespace std ;
+
+#define SPATIAL_GRID_MAX_CELLS (1 << 20)
+#define SPATIAL_GRID_MAX_FEDERATES 64
+
+// Areas of interest of the bridge federates, in the coordinates of the
+// positions given by PositionTracker. The bounding box of the areas is
+// divided into a uniform grid ; each cell holds the federates whose areas
+// cover it fully, and those whose areas cover it partly, as bit masks
+// indexed by federate id, with the list of the areas that cover it partly.
+// Federates without area are interested everywhere.
+// Built once, then read only (and shared by the federate threads) ; it is
+// only rebuilt when federations are added or removed at runtime, which the
+// threaded mode does not do.
+class SpatialGrid
+{
+public:
+    typedef unsigned long long Mask ;
+
+    SpatialGrid();
+    ~SpatialGrid();
+
+    void setCell(double);
+    void addArea(int, double, double, double, double);
+    void removeAreas(int);
+    void build(int);
+
+    bool enabled(void);
+    bool restricts(int);
+    Mask lookup(double, double);
+
+private:
+    struct Area {
+        int id ;
+        double xmin, ymin, xmax, ymax ;
+    };
+
+    vector<Area> areas ;
+    double cell ;
+    double xmin, ymin ; // origin of the grid
+    int nx, ny ;
+    vector<Mask> full ;
+    vector<Mask> partial ;
+    vector<int> first ; // cell -> first of its partial areas in cellAreas
+    vector<int> cellAreas ; // indexes in areas, grouped by cell
+    Mask everywhere ; // federates without area
+};
+
+#endif // SPATIAL_GRID_HH
@@ -0,0 +1,235 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#include "ValueCache.hh"
+#include <string.h>
+
+// ---------------------------------------------------------------------------
+// Record::find : index of an attribute in the record, -1 if absent
+// 
+int
+ValueCache::Record::find(RTI::AttributeHandle h)
+{
+    for (size_t j = 0 ; j < handles.size() ; j++) {
+        if (handles[j] == h) return j ;
+    }
+    return -1 ;
+}
+
+// ---------------------------------------------------------------------------
+// ValueCache
+// 
+ValueCache::ValueCache()
+{
+    calls = 0 ;
+    attributes = 0 ;
+    bytes = 0 ;
+    limit = 0 ;
+    size = 0 ;
+}
+
+// ---------------------------------------------------------------------------
+// ~ValueCache
+// 
+ValueCache::~ValueCache()
+{
+}
+
+// ---------------------------------------------------------------------------
+// setLimit : maximum size of the values, in bytes. 0 keeps nothing.
+// 
+void
+ValueCache::setLimit(size_t l)
+{
+    limit = l ;
+}
+
+// ---------------------------------------------------------------------------
+// getSize : size of the values held, in bytes
+// 
+size_t
+ValueCache::getSize(void)
+{
+    return size ;
+}
+
+// ---------------------------------------------------------------------------
+// get : record of an object, created empty if needed
+// 
+ValueCache::Record&
+ValueCache::get(RTI::ObjectHandle object)
+{
+    unordered_map<RTI::ObjectHandle, int>::iterator i = index.find(object);
+    if (i != index.end()) return records[i->second] ;
+
+    int r ;
+    if (freeRecords.empty()) {
+        r = records.size();
+        records.resize(r + 1);
+    }
+    else {
+        r = freeRecords.back();
+        freeRecords.pop_back();
+    }
+    records[r].handles.clear();
+    records[r].values.clear();
+    index[object] = r ;
+    return records[r] ;
+}
+
+// ---------------------------------------------------------------------------
+// put : remember the value of an attribute. Returns false if it does not
+// fit, the attribute is then forgotten.
+// 
+bool
+ValueCache::put(Record &record, RTI::AttributeHandle h, const char* value,
+                RTI::ULong length)
+{
+    int j = record.find(h);
+    size_t old = (j < 0) ? 0 : record.values[j].size() ;
+
+    if (size - old + length > limit) {
+        if (j >= 0) {
+            size -= old ;
+            record.handles[j] = record.handles.back();
+            record.handles.pop_back();
+            record.values[j].swap(record.values.back());
+            record.values.pop_back();
+        }
+        return false ;
+    }
+
+    if (j < 0) {
+        j = record.handles.size();
+        record.handles.push_back(h);
+        record.values.resize(j + 1);
+    }
+    record.values[j].assign(value, length);
+    size = size - old + length ;
+    return true ;
+}
+
+// ---------------------------------------------------------------------------
+// filter : copy to out the attributes whose value differs from the last one
+// sent, and remember them. Returns the number of attributes copied.
+// 
+int
+ValueCache::filter(RTI::ObjectHandle object,
+                   const RTI::AttributeHandleValuePairSet &in,
+                   RTI::AttributeHandleValuePairSet &out)
+{
+    Record &record = this->get(object);
+
+    out.empty();
+    int kept = 0 ;
+    RTI::ULong n = in.size();
+    for (RTI::ULong k = 0 ; k < n ; k++) {
+        RTI::AttributeHandle h = in.getHandle(k);
+        RTI::ULong length ;
+        const char* value = in.getValuePointer(k, length);
+
+        int j = record.find(h);
+        if (j >= 0 && record.values[j].size() == length &&
+            memcmp(record.values[j].data(), value, length) == 0) {
+            attributes++ ;
+            bytes += length ;
+            continue ;
+        }
+        this->put(record, h, value, length);
+        out.add(h, value, length);
+        kept++ ;
+    }
+    if (kept == 0) calls++ ;
+    return kept ;
+}
+
+// ---------------------------------------------------------------------------
+// store : remember the values of an update
+// 
+void
+ValueCache::store(RTI::ObjectHandle object,
+                  const RTI::AttributeHandleValuePairSet &in)
+{
+    if (limit == 0) return ;
+    Record &record = this->get(object);
+
+    RTI::ULong n = in.size();
+    for (RTI::ULong k = 0 ; k < n ; k++) {
+        RTI::ULong length ;
+        const char* value = in.getValuePointer(k, length);
+        this->put(record, in.getHandle(k), value, length);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// find : values of an object, NULL if none were sent
+// 
+ValueCache::Record*
+ValueCache::find(RTI::ObjectHandle object)
+{
+    unordered_map<RTI::ObjectHandle, int>::iterator i = index.find(object);
+    if (i == index.end()) return NULL ;
+    return &records[i->second] ;
+}
+
+// ---------------------------------------------------------------------------
+// erase
+// 
+void
+ValueCache::erase(RTI::ObjectHandle object)
+{
+    unordered_map<RTI::ObjectHandle, int>::iterator i = index.find(object);
+    if (i == index.end()) return ;
+    Record &record = records[i->second] ;
+    for (size_t j = 0 ; j < record.values.size() ; j++) {
+        size -= record.values[j].size();
+    }
+    record.handles.clear();
+    record.values.clear();
+    freeRecords.push_back(i->second);
+    index.erase(i);
+}
+
+// ---------------------------------------------------------------------------
+// erase : forget some attributes of an object, their next values are sent
+// whatever they are
+// 
+void
+ValueCache::erase(RTI::ObjectHandle object, 
+                  const RTI::AttributeHandleSet &attributes)
+{
+    Record* record = this->find(object);
+    if (record == NULL) return ;
+    for (RTI::ULong k = 0 ; k < attributes.size() ; k++) {
+        int j = record->find(attributes.getHandle(k));
+        if (j < 0) continue ;
+        size -= record->values[j].size();
+        record->handles.erase(record->handles.begin() + j);
+        record->values.erase(record->values.begin() + j);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// clear
+// 
+void
+ValueCache::clear(void)
+{
+    index.clear();
+    freeRecords.clear();
+    records.clear();
+    size = 0 ;
+}
@@ -0,0 +1,71 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+#ifndef VALUE_CACHE_HH
+#define VALUE_CACHE_HH
+
+#include <config.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <RTI.hh>
+
+using namespace std ;
+
+// Last attribute values sent for each object. The values held are bounded
+// by a size in bytes ; a value that does not fit is not kept (and neither
+// is the previous value of the attribute).
+class ValueCache
+{
+public:
+    class Record {
+    public:
+        int find(RTI::AttributeHandle);
+        vector<RTI::AttributeHandle> handles ;
+        vector<string> values ;
+    };
+
+    ValueCache();
+    ~ValueCache();
+
+    void setLimit(size_t);
+    size_t getSize(void);
+
+    int filter(RTI::ObjectHandle, const RTI::AttributeHandleValuePairSet&,
+               RTI::AttributeHandleValuePairSet&);
+    void store(RTI::ObjectHandle, const RTI::AttributeHandleValuePairSet&);
+    Record* find(RTI::ObjectHandle);
+    void erase(RTI::ObjectHandle);
+    void erase(RTI::ObjectHandle, const RTI::AttributeHandleSet&);
+    void clear(void);
+
+    // Saved by filter
+    unsigned long calls ;
+    unsigned long attributes ;
+    unsigned long bytes ;
+
+private:
+    Record& get(RTI::ObjectHandle);
+    bool put(Record&, RTI::AttributeHandle, const char*, RTI::ULong);
+
+    unordered_map<RTI::ObjectHandle, int> index ;
+    vector<Record> records ;
+    vector<int> freeRecords ;
+    size_t limit ; // bytes
+    size_t size ;
+};
+
+#endif // VALUE_CACHE_HH
@@ -0,0 +1,48 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+
+#include "XmlProp.hh"
+
+// ---------------------------------------------------------------------------
+// Take : copy of a string returned by libxml2, which is freed
+// 
+static string
+Take(xmlChar* p)
+{
+    if (p == NULL) return "" ;
+    string s((const char *) p);
+    xmlFree(p);
+    return s ;
+}
+
+// ---------------------------------------------------------------------------
+// GetXmlProp : value of an attribute of a node
+// 
+string
+GetXmlProp(xmlNodePtr node, const char *name)
+{
+    return Take(xmlGetProp(node, (const xmlChar*) name));
+}
+
+// ---------------------------------------------------------------------------
+// GetXmlProp : value of an attribute of the current node of a reader
+// 
+string
+GetXmlProp(xmlTextReaderPtr reader, const xmlChar *name)
+{
+    return Take(xmlTextReaderGetAttribute(reader, name));
+}
@@ -0,0 +1,32 @@
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+//
+// bridge_hla 
+// Implementation for IEEE HLA bridges between federations (Compliant with CERTI RTI)
+// 
+// Copyright (C) 2023  ISAE-SUPAERO
+//
+// Authors: Benoit Breholée
+//          Jean-Baptiste Chaudron
+//
+// email:   jean-baptiste.chaudron@isae-supaero.fr
+//
+//----------------------------------------------------------------------
+//----------------------------------------------------------------------
+
+
+#ifndef XML_PROP_HH
+#define XML_PROP_HH
+
+#include <string>
+#include <libxml/tree.h>
+#include <libxml/xmlreader.h>
+
+using namespace std ;
+
+// Values of XML attributes, empty if missing, for the DOM of the bridge
+// configuration and for the reader of the FOM
+string GetXmlProp(xmlNodePtr, const char *);
+string GetXmlProp(xmlTextReaderPtr, const xmlChar *);
+
+#endif // XML_PROP_HH
@@ -18,6 +18,8 @@
 
 #include "Fed.hh"
 #include "Federate.hh"
+#include "XmlProp.hh"
+#include "Clock.hh"
 
 #include "cmdline.h"
 
@@ -27,17 +29,61 @@
 #include <RTI.hh>
 
 #include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
 #include <vector>
 #include <string>
 #include <signal.h>
 #include <csignal>
 #include <unistd.h>
+#include <fcntl.h>
+#include <thread>
+#include <chrono>
+#include <atomic>
+
+// Federate ids are bits of the spatial grid masks
+#define BRIDGE_MAX_FEDERATES 64
 
 using std::string ;
 
+// Federation added at runtime : it joins on a worker thread, and is
+// connected to the others between two cycles of the main loop
+struct PendingFederate {
+    Federate* f ;
+    thread joiner ;
+    atomic<bool> done ;
+    bool joined ; // set before done
+};
+
+// What the federations are set up with, including those added at runtime
+struct BridgeContext {
+    gengetopt_args_info* args ;
+    Federate::WaitPolicy wait ;
+    SpatialGrid* grid ;
+    CanonicalModel* model ;
+    LbtsBoard* board ;
+    int id ; // of the next new federate
+    vector<int> freeIds ; // of removed federates, given again first
+    vector<PendingFederate*> pending ;
+};
+
 extern "C" void HandleSignal(int);
+static Federate* CreateFederate(xmlDocPtr, xmlNodePtr, BridgeContext&);
+static void AddFederations(const char *, vector<Federate*>&, BridgeContext&);
+static void FinishFederations(vector<Federate*>&, BridgeContext&, bool);
+static void RemoveFederation(string, vector<Federate*>&, BridgeContext&);
+static int AllocateId(BridgeContext&);
+static void ReleaseId(BridgeContext&, int);
+static void ProcessControl(int, string&, vector<Federate*>&, BridgeContext&);
 static void ProcessXmlNode(xmlDocPtr, xmlNodePtr, const char *, string&);
-bool stop = false ;
+static void ProcessDeadReckoning(xmlNodePtr, DeadReckoning&);
+static void ProcessRegion(xmlNodePtr, Federation&);
+static void ProcessSpatial(xmlNodePtr, Federate&, SpatialGrid&);
+static void ProcessNameFilter(xmlNodePtr, NameFilter&);
+static void ProcessAllowList(xmlNodePtr, Federation&);
+static void ProcessRoute(xmlNodePtr, RoutingTable&);
+volatile bool stop = false ;
 
 // ---------------------------------------------------------------------------
 // main
@@ -45,12 +91,14 @@ bool stop = false ;
 int 
 main(int argc, char** argv)
 {
-    int id = 1 ;
     vector<Federate*> feds ;
+    SpatialGrid grid ;
+    CanonicalModel model ;
+    LbtsBoard board(BRIDGE_MAX_FEDERATES);
+    BridgeContext bridge ;
     char* configfile ;
     xmlDocPtr doc ;
     xmlNodePtr cur ;
-    xmlNodePtr fed ;
 
     gengetopt_args_info args_info;
     if(cmdline_parser(argc, argv, &args_info) != 0) exit(1) ;
@@ -58,6 +106,17 @@ main(int argc, char** argv)
     std::signal(SIGINT, HandleSignal);
     cout << PACKAGE << "-" << VERSION << endl ;
 
+    Federate::WaitPolicy wait = Federate::WAIT_SPIN ;
+    if(!strcmp(args_info.wait_arg, "adaptive")) wait = Federate::WAIT_ADAPTIVE ;
+    else if(!strcmp(args_info.wait_arg, "block")) wait = Federate::WAIT_BLOCK ;
+
+    bridge.args = &args_info ;
+    bridge.wait = wait ;
+    bridge.grid = &grid ;
+    bridge.model = &model ;
+    bridge.board = &board ;
+    bridge.id = 1 ;
+
     configfile = args_info.config_arg ;
     doc = xmlParseFile(configfile);
     cur = xmlDocGetRootElement(doc);
@@ -72,44 +131,15 @@ main(int argc, char** argv)
     }
     cur = cur->xmlChildrenNode ;
     while(cur != NULL) {
+        if((!xmlStrcmp(cur->name, (const xmlChar*) "grid"))) {
+            grid.setCell(atof(GetXmlProp(cur, "cell").c_str()));
+        }
         if((!xmlStrcmp(cur->name, (const xmlChar*) "federation"))) {
-            cout << "Federation (" ;
-
-            string federation ;
-            string federate ;
-            string fedfile ;
-            string host ;
-            string synchro ;
-            string filter ;
-
-            fed = cur->xmlChildrenNode ;
-
-            while (fed != NULL) {
-                ProcessXmlNode(doc, fed, "name", federation);
-                ProcessXmlNode(doc, fed, "host", host);
-                ProcessXmlNode(doc, fed, "filter", filter);
-                ProcessXmlNode(doc, fed, "surrogate", federate);
-                ProcessXmlNode(doc, fed, "file", fedfile);
-                ProcessXmlNode(doc, fed, "synchro", synchro);
-                fed = fed->next ;
-            }      
-            if (federation.empty() || federate.empty() || fedfile.empty() || 
-                host.empty()) {
-                cout << "Error: missing information for a federation" << endl ;
+            Federate *f = CreateFederate(doc, cur, bridge);
+            if (f == NULL) {
                 xmlFreeDoc(doc);
                 exit(1);
             }
-
-            cout << federation << "/" << federate << "/" << fedfile << ")" 
-                 << endl ;
-            Federate *f = new Federate(federation, federate, fedfile, host, 
-                                       filter);
-            f->setId(id++);
-            f->setVerbose(args_info.verbose_flag);
-            if (synchro != "") {
-                cout << "(synchro: " << synchro << ")" << endl ;
-                f->setSynchro(synchro);
-            }
             feds.push_back(f);
         }
         cur=cur->next;
@@ -117,28 +147,67 @@ main(int argc, char** argv)
   
     xmlFreeDoc(doc);
 
+    for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+        (*i)->setBoard(&board);
+    }
+
+    grid.build(bridge.id);
+    if(grid.enabled()) {
+        for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+            (*i)->setGrid(&grid);
+        }
+    }
+
+    // One thread per federation : each one joins (retrying until it
+    // succeeds) and resolves the handles of its FOM, independently of the
+    // others
     cout << "Bridge - Joining federations" << endl ;
-    bool joined = false ;
-    while (!joined) {
-        joined = true ;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    vector<thread> joiners ;
+    for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+        Federate* f = *i ;
+        joiners.push_back(thread([f] () {
+            while (f->join() && !stop) ;
+        }));
+    }
+    for(vector<thread>::iterator i=joiners.begin(); i!=joiners.end(); i++) {
+        i->join();
+    }
+    double joining = Since(start);
+    if (stop) {
         for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
-            if ((*i)->join()) {
-                joined = false ;
-            }
-        } 
+            delete *i ;
+        }
+        cout << "Bridge - Exiting." << endl ;
+        return 0 ;
     }
 
+    // Every pair is connected even with routes : time advances stay bounded
+    // by all the federations, routes only restrict what is forwarded
     cout << "Bridge - Connecting bridge federates" << endl ;
+    start = chrono::steady_clock::now();
     for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
         for(vector<Federate*>::iterator j=feds.begin(); j!=feds.end(); j++) {
             if(i!=j) (*i)->connect(**j);
         }
     }
+    double connecting = Since(start);
 
+    // Sequential : a federate discovering objects while it initializes
+    // registers them in its peers
     cout << "Bridge - Initializing bridge federates" << endl ;
+    start = chrono::steady_clock::now();
+    for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+        (*i)->init(true);
+    }
+    double initializing = Since(start);
+
     for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
-        (*i)->init();
+        (*i)->timing();
     }
+    cout << "Bridge - Startup : join and handles " << joining 
+         << "s, connect " << connecting << "s, init " << initializing 
+         << "s" << endl ;
 
     struct sigaction a ;
     if(args_info.timer_given) {
@@ -152,11 +221,63 @@ main(int argc, char** argv)
         cout << "Bridge - Running... (press Ctrl-C to stop)" << endl ;
     }
 
-    while(!stop) {
+    int control = -1 ;
+    string commands ;
+    if(args_info.control_given) {
+        if(args_info.threads_flag) {
+            cout << "Warning: control ignored in threaded mode" << endl ;
+        }
+        else if((control = open(args_info.control_arg, 
+                                O_RDONLY | O_NONBLOCK)) < 0) {
+            cout << "Warning: unable to open control " 
+                 << args_info.control_arg << endl ;
+        }
+    }
+
+    if(args_info.threads_flag) {
+        cout << "Bridge - Starting one thread per federation" << endl ;
+        for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+            (*i)->link();
+        }
+        for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+            (*i)->start(&stop);
+        }
+        while(!stop) {
+            usleep(100000);
+        }
         for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
-            (*i)->step();
+            (*i)->wait();
         }
     }
+    else if(args_info.concurrent_flag) {
+        // Request for every federation first, then tick them all until each
+        // one is granted : a cycle lasts as long as the slowest grant.
+        while(!stop) {
+            for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+                (*i)->request();
+            }
+            bool granted = false ;
+            while(!granted && !stop) {
+                granted = true ;
+                for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+                    if(!(*i)->poll()) granted = false ;
+                }
+            }
+            if(control >= 0) ProcessControl(control, commands, feds, bridge);
+        }
+    }
+    else {
+        while(!stop) {
+            for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+                (*i)->step();
+            }
+            if(control >= 0) ProcessControl(control, commands, feds, bridge);
+        }
+    }
+    if(control >= 0) {
+        FinishFederations(feds, bridge, true);
+        close(control);
+    }
 
     for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
         delete *i ;
@@ -179,6 +300,280 @@ HandleSignal(int signum)
     }
 }
 
+// ---------------------------------------------------------------------------
+// CreateFederate : bridge federate of a <federation> element, NULL if some
+// information is missing
+// 
+Federate*
+CreateFederate(xmlDocPtr doc, xmlNodePtr cur, BridgeContext &bridge)
+{
+    gengetopt_args_info &args_info = *bridge.args ;
+    xmlNodePtr fed ;
+
+    cout << "Federation (" ;
+
+    string federation ;
+    string federate ;
+    string fedfile ;
+    string host ;
+    string synchro ;
+    string filter ;
+
+    fed = cur->xmlChildrenNode ;
+
+    while (fed != NULL) {
+        ProcessXmlNode(doc, fed, "name", federation);
+        ProcessXmlNode(doc, fed, "host", host);
+        ProcessXmlNode(doc, fed, "filter", filter);
+        ProcessXmlNode(doc, fed, "surrogate", federate);
+        ProcessXmlNode(doc, fed, "file", fedfile);
+        ProcessXmlNode(doc, fed, "synchro", synchro);
+        fed = fed->next ;
+    }      
+    if (federation.empty() || federate.empty() || fedfile.empty() || 
+        host.empty()) {
+        cout << "Error: missing information for a federation" << endl ;
+        return NULL ;
+    }
+
+    cout << federation << "/" << federate << "/" << fedfile << ")" 
+         << endl ;
+    int id = AllocateId(bridge);
+    if (id < 0) {
+        cout << "Error: too many federations (" << BRIDGE_MAX_FEDERATES - 1 
+             << " at most)" << endl ;
+        return NULL ;
+    }
+    Federate *f = new Federate(federation, federate, fedfile, host, 
+                               filter);
+    f->setId(id);
+    f->setVerbose(args_info.verbose_flag);
+    f->setWaitPolicy(bridge.wait, args_info.tick_min_arg, 
+                     args_info.tick_max_arg, args_info.spin_arg);
+    f->setCoalescing(args_info.coalesce_arg);
+    f->setDelta(args_info.delta_flag);
+    f->setCacheLimit((size_t) args_info.cache_arg * 1024);
+    f->setAdvisories(args_info.advisories_flag);
+    f->setModel(bridge.model);
+    if (synchro != "") {
+        cout << "(synchro: " << synchro << ")" << endl ;
+        f->setSynchro(synchro);
+    }
+    for (fed = cur->xmlChildrenNode ; fed != NULL ; fed = fed->next) {
+        ProcessDeadReckoning(fed, f->getDeadReckoning());
+        ProcessRegion(fed, f->getFederation());
+        ProcessSpatial(fed, *f, *bridge.grid);
+        ProcessNameFilter(fed, f->getNameFilter());
+        ProcessAllowList(fed, f->getFederation());
+        ProcessRoute(fed, f->getRoutes());
+    }
+    return f ;
+}
+
+// ---------------------------------------------------------------------------
+// AddFederations : join the federations described in a file, while the
+// bridge runs. The root element is a <federation>, or an <interfederation>
+// with several of them. Each one joins on its own thread, so that the
+// bridge goes on forwarding meanwhile ; FinishFederations does the rest.
+// 
+void
+AddFederations(const char *file, vector<Federate*> &feds, 
+               BridgeContext &bridge)
+{
+    xmlDocPtr doc = xmlParseFile(file);
+    xmlNodePtr root = doc ? xmlDocGetRootElement(doc) : NULL ;
+    if (root == NULL) {
+        cout << "Warning: no federation in " << file << endl ;
+        if (doc) xmlFreeDoc(doc);
+        return ;
+    }
+    vector<xmlNodePtr> nodes ;
+    if (!xmlStrcmp(root->name, (const xmlChar*) "federation")) 
+        nodes.push_back(root);
+    else if (!xmlStrcmp(root->name, (const xmlChar*) "interfederation")) {
+        for (xmlNodePtr n = root->xmlChildrenNode ; n != NULL ; n = n->next) {
+            if (!xmlStrcmp(n->name, (const xmlChar*) "federation")) 
+                nodes.push_back(n);
+        }
+    }
+
+    for (size_t k = 0 ; k < nodes.size() ; k++) {
+        Federate *f = CreateFederate(doc, nodes[k], bridge);
+        if (f == NULL) continue ;
+
+        bool duplicate = false ;
+        for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+            if ((*i)->getFederationName() == f->getFederationName()) 
+                duplicate = true ;
+        }
+        for(vector<PendingFederate*>::iterator i=bridge.pending.begin(); 
+            i!=bridge.pending.end(); i++) {
+            if ((*i)->f->getFederationName() == f->getFederationName()) 
+                duplicate = true ;
+        }
+        if (duplicate) {
+            cout << "Warning: federation " << f->getFederationName() 
+                 << " already bridged" << endl ;
+            ReleaseId(bridge, f->getId());
+            delete f ;
+            continue ;
+        }
+
+        f->setBoard(bridge.board);
+        PendingFederate* p = new PendingFederate ;
+        p->f = f ;
+        p->joined = false ;
+        p->done = false ;
+        p->joiner = thread([p] () {
+            p->joined = (p->f->join() == 0) ;
+            p->done = true ;
+        });
+        bridge.pending.push_back(p);
+    }
+    xmlFreeDoc(doc);
+}
+
+// ---------------------------------------------------------------------------
+// FinishFederations : connect the federations added at runtime which have
+// joined, and drop those which could not. With discard (the bridge stops),
+// wait for every one of them and drop them all.
+// 
+void
+FinishFederations(vector<Federate*> &feds, BridgeContext &bridge, 
+                  bool discard)
+{
+    vector<PendingFederate*>::iterator p = bridge.pending.begin();
+    while (p != bridge.pending.end()) {
+        if (!discard && !(*p)->done) {
+            p++ ;
+            continue ;
+        }
+        (*p)->joiner.join();
+        Federate *f = (*p)->f ;
+        bool joined = (*p)->joined ;
+        delete *p ;
+        p = bridge.pending.erase(p);
+
+        if (discard || !joined) {
+            if (!joined) cout << "Warning: unable to join federation " 
+                              << f->getFederationName() << endl ;
+            ReleaseId(bridge, f->getId());
+            delete f ;
+            continue ;
+        }
+        bridge.grid->build(bridge.id);
+        if (bridge.grid->enabled()) {
+            for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+                (*i)->setGrid(bridge.grid);
+            }
+            f->setGrid(bridge.grid);
+        }
+        for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+            f->connect(**i);
+            (*i)->connect(*f);
+        }
+        f->init(false);
+        for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+            (*i)->reroute();
+        }
+        feds.push_back(f);
+        cout << "Bridge - Added federation " << f->getFederationName() << endl ;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// RemoveFederation : resign a federation while the bridge runs. The
+// surrogates of its objects are deleted from the other federations, the
+// ones of their objects go with the resignation.
+// 
+void
+RemoveFederation(string name, vector<Federate*> &feds, BridgeContext &bridge)
+{
+    vector<Federate*>::iterator f = feds.begin();
+    while (f != feds.end() && (*f)->getFederationName() != name) f++ ;
+    if (f == feds.end()) {
+        cout << "Warning: no federation " << name << " to remove" << endl ;
+        return ;
+    }
+    Federate *removed = *f ;
+    feds.erase(f);
+
+    removed->withdraw();
+    for(vector<Federate*>::iterator i=feds.begin(); i!=feds.end(); i++) {
+        (*i)->disconnect(*removed);
+        (*i)->reroute();
+    }
+    ReleaseId(bridge, removed->getId());
+    delete removed ;
+    bridge.grid->build(bridge.id);
+    cout << "Bridge - Removed federation " << name << endl ;
+}
+
+// ---------------------------------------------------------------------------
+// AllocateId : id of a new federate, -1 if there are too many. Ids index
+// the LBTS board and the spatial grid masks : those of removed federates
+// are given again.
+// 
+int
+AllocateId(BridgeContext &bridge)
+{
+    if (!bridge.freeIds.empty()) {
+        int id = bridge.freeIds.back();
+        bridge.freeIds.pop_back();
+        return id ;
+    }
+    if (bridge.id >= BRIDGE_MAX_FEDERATES) return -1 ;
+    return bridge.id++ ;
+}
+
+// ---------------------------------------------------------------------------
+// ReleaseId : id of a federate which is deleted, with its LBTS board slot
+// and its areas of interest
+// 
+void
+ReleaseId(BridgeContext &bridge, int id)
+{
+    bridge.grid->removeAreas(id);
+    bridge.board->post(id, 0.0);
+    bridge.freeIds.push_back(id);
+}
+
+// ---------------------------------------------------------------------------
+// ProcessControl : commands read from the control file, one per line,
+// "add FILE" or "remove NAME". Partial lines are kept for the next call.
+// Federations added by earlier calls are connected once they joined.
+// 
+void
+ProcessControl(int fd, string &buffer, vector<Federate*> &feds, 
+               BridgeContext &bridge)
+{
+    FinishFederations(feds, bridge, false);
+
+    char b[256] ;
+    ssize_t n ;
+    while ((n = read(fd, b, sizeof(b))) > 0) buffer.append(b, n);
+
+    size_t eol ;
+    while ((eol = buffer.find('\n')) != string::npos) {
+        string line = buffer.substr(0, eol);
+        buffer.erase(0, eol + 1);
+
+        size_t sp = line.find(' ');
+        string command = line.substr(0, sp);
+        string arg = sp == string::npos ? "" : line.substr(sp + 1);
+        while (!arg.empty() && isspace((unsigned char) arg[arg.size() - 1])) 
+            arg.erase(arg.size() - 1);
+        if (command.empty()) continue ;
+
+        if (command == "add" && !arg.empty()) 
+            AddFederations(arg.c_str(), feds, bridge);
+        else if (command == "remove" && !arg.empty()) 
+            RemoveFederation(arg, feds, bridge);
+        else 
+            cout << "Warning: unknown control command " << line << endl ;
+    }
+}
+
 // ---------------------------------------------------------------------------
 void
 ProcessXmlNode(xmlDocPtr doc, xmlNodePtr node, const char *name, string &s)
@@ -188,3 +583,160 @@ ProcessXmlNode(xmlDocPtr doc, xmlNodePtr node, const char *name, string &s)
                    xmlNodeListGetString(doc, node->xmlChildrenNode, 1));
     }
 }
+
+// ---------------------------------------------------------------------------
+// ProcessDeadReckoning : <deadReckoning class="C" heartbeat="T"> with
+// <attribute name="A" encoding="E" threshold="D"/> children
+// 
+void
+ProcessDeadReckoning(xmlNodePtr node, DeadReckoning &dr)
+{
+    if (xmlStrcmp(node->name, (const xmlChar*) "deadReckoning")) return ;
+
+    string c = GetXmlProp(node, "class");
+    if (c.empty()) {
+        cout << "Warning: dead reckoning without class" << endl ;
+        return ;
+    }
+    dr.addClass(c, atof(GetXmlProp(node, "heartbeat").c_str()));
+
+    for (xmlNodePtr a = node->xmlChildrenNode ; a != NULL ; a = a->next) {
+        if (xmlStrcmp(a->name, (const xmlChar*) "attribute")) continue ;
+        string name = GetXmlProp(a, "name");
+        string encoding = GetXmlProp(a, "encoding");
+        DeadReckoning::Encoding e = DeadReckoning::DOUBLE ;
+        if (!encoding.empty() && !DeadReckoning::parseEncoding(encoding, e)) {
+            cout << "Warning: unknown encoding " << encoding << " for "
+                 << c << "." << name << endl ;
+            continue ;
+        }
+        dr.addAttribute(c, name, e, atof(GetXmlProp(a, "threshold").c_str()));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ProcessRegion : <region space="S"> with <dimension name="D" lower="L"
+// upper="U"/> children, one extent of the subscription region of S
+// 
+void
+ProcessRegion(xmlNodePtr node, Federation &f)
+{
+    if (xmlStrcmp(node->name, (const xmlChar*) "region")) return ;
+
+    string space = GetXmlProp(node, "space");
+    if (space.empty()) {
+        cout << "Warning: region without routing space" << endl ;
+        return ;
+    }
+    RegionExtent extent ;
+    for (xmlNodePtr d = node->xmlChildrenNode ; d != NULL ; d = d->next) {
+        if (xmlStrcmp(d->name, (const xmlChar*) "dimension")) continue ;
+        RegionBound b ;
+        b.dimension = GetXmlProp(d, "name");
+        b.lower = strtoul(GetXmlProp(d, "lower").c_str(), NULL, 10);
+        b.upper = strtoul(GetXmlProp(d, "upper").c_str(), NULL, 10);
+        extent.push_back(b);
+    }
+    f.addRegionExtent(space, extent);
+}
+
+// ---------------------------------------------------------------------------
+// ProcessSpatial : <position class="C" x="X" y="Y" encoding="E"/>, the
+// position attributes of a class reflected by the federation, and 
+// <area xmin="" ymin="" xmax="" ymax=""/>, an area of interest of the
+// federation
+// 
+void
+ProcessSpatial(xmlNodePtr node, Federate &f, SpatialGrid &grid)
+{
+    if (!xmlStrcmp(node->name, (const xmlChar*) "position")) {
+        string encoding = GetXmlProp(node, "encoding");
+        DeadReckoning::Encoding e = DeadReckoning::DOUBLE ;
+        if (!encoding.empty() && !DeadReckoning::parseEncoding(encoding, e)) {
+            cout << "Warning: unknown encoding " << encoding << endl ;
+            return ;
+        }
+        f.getPositions().addClass(GetXmlProp(node, "class"), 
+                                  GetXmlProp(node, "x"),
+                                  GetXmlProp(node, "y"), e);
+    }
+    else if (!xmlStrcmp(node->name, (const xmlChar*) "area")) {
+        grid.addArea(f.getId(),
+                     atof(GetXmlProp(node, "xmin").c_str()),
+                     atof(GetXmlProp(node, "ymin").c_str()),
+                     atof(GetXmlProp(node, "xmax").c_str()),
+                     atof(GetXmlProp(node, "ymax").c_str()));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ProcessNameFilter : <include prefix="P"/>, <include glob="G"/> or
+// <include regex="R"/>, and the same with <exclude>, patterns on the names
+// of the objects forwarded from the federation
+// 
+void
+ProcessNameFilter(xmlNodePtr node, NameFilter &filter)
+{
+    bool include = !xmlStrcmp(node->name, (const xmlChar*) "include");
+    if (!include && xmlStrcmp(node->name, (const xmlChar*) "exclude")) return ;
+
+    string p ;
+    if (!(p = GetXmlProp(node, "prefix")).empty())
+        filter.add(include, NameFilter::PREFIX, p);
+    else if (!(p = GetXmlProp(node, "glob")).empty())
+        filter.add(include, NameFilter::GLOB, p);
+    else if (!(p = GetXmlProp(node, "regex")).empty())
+        filter.add(include, NameFilter::REGEX, p);
+    else
+        cout << "Warning: " << node->name << " without pattern" << endl ;
+}
+
+// ---------------------------------------------------------------------------
+// ProcessAllowList : <publish class="C"> or <subscribe class="C">, with
+// optional <attribute name="A"/> children, and <publish interaction="I"/>
+// or <subscribe interaction="I"/> ; what the bridge exchanges with the
+// federation, everything by default
+// 
+void
+ProcessAllowList(xmlNodePtr node, Federation &f)
+{
+    AllowList* list ;
+    if (!xmlStrcmp(node->name, (const xmlChar*) "publish"))
+        list = &f.getPublications();
+    else if (!xmlStrcmp(node->name, (const xmlChar*) "subscribe"))
+        list = &f.getSubscriptions();
+    else return ;
+
+    string c = GetXmlProp(node, "class");
+    string i = GetXmlProp(node, "interaction");
+    if (!i.empty()) list->addInteraction(i);
+    if (c.empty()) {
+        if (i.empty()) cout << "Warning: " << node->name 
+                            << " without class or interaction" << endl ;
+        return ;
+    }
+    list->addClass(c);
+    for (xmlNodePtr a = node->xmlChildrenNode ; a != NULL ; a = a->next) {
+        if (xmlStrcmp(a->name, (const xmlChar*) "attribute")) continue ;
+        list->addAttribute(c, GetXmlProp(a, "name"));
+    }
+}
+
+// ---------------------------------------------------------------------------
+// ProcessRoute : <route to="F"/>, optionally with class="C" or
+// interaction="I", what the federation forwards to federation F. Without
+// any route, everything goes to every federation.
+// 
+void
+ProcessRoute(xmlNodePtr node, RoutingTable &routes)
+{
+    if (xmlStrcmp(node->name, (const xmlChar*) "route")) return ;
+
+    string to = GetXmlProp(node, "to");
+    if (to.empty()) {
+        cout << "Warning: route without destination" << endl ;
+        return ;
+    }
+    routes.addRoute(to, GetXmlProp(node, "class"), 
+                    GetXmlProp(node, "interaction"));
+}
@@ -53,6 +53,17 @@ cmdline_parser_print_help (void)
   printf("   -cSTRING   --config=STRING  configuration file\n");
   printf("   -tINT      --timer=INT      timer\n");
   printf("   -v         --verbose        verbose mode (default=off)\n");
+  printf("   -T         --threads        one thread per federation (default=off)\n");
+  printf("   -wSTRING   --wait=STRING    wait policy: spin, block or adaptive (default='spin')\n");
+  printf("   -mDOUBLE   --tick-min=DOUBLE  minimum blocking tick, in seconds (default='0')\n");
+  printf("   -MDOUBLE   --tick-max=DOUBLE  maximum blocking tick, in seconds (default='0.1')\n");
+  printf("   -sINT      --spin=INT       non-blocking ticks before blocking (default='1000')\n");
+  printf("   -C         --concurrent     request time advances for all federations before waiting (default=off)\n");
+  printf("   -a         --advisories     forward only what has subscribers, from the RTI advisories (default=off)\n");
+  printf("   -d         --delta          forward changed attribute values only (default=off)\n");
+  printf("   -kDOUBLE   --coalesce=DOUBLE  coalescing window for object updates, 0 disables (default='0')\n");
+  printf("   -lINT      --cache=INT      size of the last value cache, in kilobytes (default='16384')\n");
+  printf("   -xSTRING   --control=STRING  control file or FIFO, to add and remove federations at runtime\n");
 }
 
 
@@ -81,9 +92,31 @@ cmdline_parser (int argc, char * const *argv, struct gengetopt_args_info *args_i
   args_info->config_given = 0 ;
   args_info->timer_given = 0 ;
   args_info->verbose_given = 0 ;
+  args_info->threads_given = 0 ;
+  args_info->wait_given = 0 ;
+  args_info->tick_min_given = 0 ;
+  args_info->tick_max_given = 0 ;
+  args_info->spin_given = 0 ;
+  args_info->concurrent_given = 0 ;
+  args_info->advisories_given = 0 ;
+  args_info->delta_given = 0 ;
+  args_info->coalesce_given = 0 ;
+  args_info->cache_given = 0 ;
+  args_info->control_given = 0 ;
 #define clear_args() { \
   args_info->config_arg = NULL; \
   args_info->verbose_flag = 0;\
+  args_info->threads_flag = 0;\
+  args_info->wait_arg = strdup("spin") ;\
+  args_info->tick_min_arg = 0.0 ;\
+  args_info->tick_max_arg = 0.1 ;\
+  args_info->spin_arg = 1000 ;\
+  args_info->concurrent_flag = 0;\
+  args_info->advisories_flag = 0;\
+  args_info->delta_flag = 0;\
+  args_info->coalesce_arg = 0 ;\
+  args_info->cache_arg = 16384 ;\
+  args_info->control_arg = NULL; \
 }
 
   clear_args();
@@ -102,10 +135,21 @@ cmdline_parser (int argc, char * const *argv, struct gengetopt_args_info *args_i
         { "config",	1, NULL, 'c' },
         { "timer",	1, NULL, 't' },
         { "verbose",	0, NULL, 'v' },
+        { "threads",	0, NULL, 'T' },
+        { "wait",	1, NULL, 'w' },
+        { "tick-min",	1, NULL, 'm' },
+        { "tick-max",	1, NULL, 'M' },
+        { "spin",	1, NULL, 's' },
+        { "concurrent",	0, NULL, 'C' },
+        { "advisories",	0, NULL, 'a' },
+        { "delta",	0, NULL, 'd' },
+        { "coalesce",	1, NULL, 'k' },
+        { "cache",	1, NULL, 'l' },
+        { "control",	1, NULL, 'x' },
         { NULL,	0, NULL, 0 }
       };
 
-      c = getopt_long (argc, argv, "hVc:t:v", long_options, &option_index);
+      c = getopt_long (argc, argv, "hVc:t:vTw:m:M:s:Cadk:l:x:", long_options, &option_index);
 
       if (c == -1) break;	/* Exit from `while (1)' loop.  */
 
@@ -154,6 +198,133 @@ cmdline_parser (int argc, char * const *argv, struct gengetopt_args_info *args_i
           args_info->verbose_flag = !(args_info->verbose_flag);
           break;
 
+        case 'T':	/* one thread per federation.  */
+          if (args_info->threads_given)
+            {
+              fprintf (stderr, "%s: `--threads' (`-T') option given more than once\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->threads_given = 1;
+          args_info->threads_flag = !(args_info->threads_flag);
+          break;
+
+        case 'w':	/* wait policy.  */
+          if (args_info->wait_given)
+            {
+              fprintf (stderr, "%s: `--wait' (`-w') option given more than once\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->wait_given = 1;
+          if (strcmp (optarg, "spin") && strcmp (optarg, "block") && strcmp (optarg, "adaptive"))
+            {
+              fprintf (stderr, "%s: `--wait' (`-w') must be spin, block or adaptive\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->wait_arg = strdup (optarg);
+          break;
+
+        case 'm':	/* minimum blocking tick.  */
+          if (args_info->tick_min_given)
+            {
+              fprintf (stderr, "%s: `--tick-min' (`-m') option given more than once\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->tick_min_given = 1;
+          args_info->tick_min_arg = strtod (optarg, NULL);
+          break;
+
+        case 'M':	/* maximum blocking tick.  */
+          if (args_info->tick_max_given)
+            {
+              fprintf (stderr, "%s: `--tick-max' (`-M') option given more than once\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->tick_max_given = 1;
+          args_info->tick_max_arg = strtod (optarg, NULL);
+          break;
+
+        case 's':	/* non-blocking ticks before blocking.  */
+          if (args_info->spin_given)
+            {
+              fprintf (stderr, "%s: `--spin' (`-s') option given more than once\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->spin_given = 1;
+          args_info->spin_arg = atoi (optarg);
+          break;
+
+        case 'C':	/* request time advances for all federations before waiting.  */
+          if (args_info->concurrent_given)
+            {
+              fprintf (stderr, "%s: `--concurrent' (`-C') option given more than once\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->concurrent_given = 1;
+          args_info->concurrent_flag = !(args_info->concurrent_flag);
+          break;
+
+        case 'a':	/* forward only what has subscribers.  */
+          if (args_info->advisories_given)
+            {
+              fprintf (stderr, "%s: `--advisories' (`-a') option given more than once\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->advisories_given = 1;
+          args_info->advisories_flag = !(args_info->advisories_flag);
+          break;
+
+        case 'd':	/* forward changed attribute values only.  */
+          if (args_info->delta_given)
+            {
+              fprintf (stderr, "%s: `--delta' (`-d') option given more than once\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->delta_given = 1;
+          args_info->delta_flag = !(args_info->delta_flag);
+          break;
+
+        case 'k':	/* coalescing window for object updates.  */
+          if (args_info->coalesce_given)
+            {
+              fprintf (stderr, "%s: `--coalesce' (`-k') option given more than once\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->coalesce_given = 1;
+          args_info->coalesce_arg = strtod (optarg, NULL);
+          break;
+
+        case 'l':	/* size of the last value cache.  */
+          if (args_info->cache_given)
+            {
+              fprintf (stderr, "%s: `--cache' (`-l') option given more than once\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->cache_given = 1;
+          args_info->cache_arg = atoi (optarg);
+          break;
+
+        case 'x':	/* control file or FIFO.  */
+          if (args_info->control_given)
+            {
+              fprintf (stderr, "%s: `--control' (`-x') option given more than once\n", PACKAGE);
+              clear_args ();
+              exit (EXIT_FAILURE);
+            }
+          args_info->control_given = 1;
+          args_info->control_arg = strdup (optarg);
+          break;
+
 
         case 0:	/* Long option with no short option */
 
@@ -23,12 +23,34 @@ struct gengetopt_args_info
   char * config_arg;	/* configuration file.  */
   int timer_arg;	/* timer.  */
   int verbose_flag;	/* verbose mode (default=off).  */
+  int threads_flag;	/* one thread per federation (default=off).  */
+  char * wait_arg;	/* wait policy: spin, block or adaptive (default='spin').  */
+  double tick_min_arg;	/* minimum blocking tick, in seconds (default='0').  */
+  double tick_max_arg;	/* maximum blocking tick, in seconds (default='0.1').  */
+  int spin_arg;	/* non-blocking ticks before blocking (default='1000').  */
+  int concurrent_flag;	/* request time advances for all federations before waiting (default=off).  */
+  int advisories_flag;	/* forward only what has subscribers, from the RTI advisories (default=off).  */
+  int delta_flag;	/* forward changed attribute values only (default=off).  */
+  double coalesce_arg;	/* coalescing window for object updates, 0 disables (default='0').  */
+  int cache_arg;	/* size of the last value cache, in kilobytes (default='16384').  */
+  char * control_arg;	/* control file or FIFO, to add and remove federations at runtime.  */
 
   int help_given ;	/* Whether help was given.  */
   int version_given ;	/* Whether version was given.  */
   int config_given ;	/* Whether config was given.  */
   int timer_given ;	/* Whether timer was given.  */
   int verbose_given ;	/* Whether verbose was given.  */
+  int threads_given ;	/* Whether threads was given.  */
+  int wait_given ;	/* Whether wait was given.  */
+  int tick_min_given ;	/* Whether tick-min was given.  */
+  int tick_max_given ;	/* Whether tick-max was given.  */
+  int spin_given ;	/* Whether spin was given.  */
+  int concurrent_given ;	/* Whether concurrent was given.  */
+  int advisories_given ;	/* Whether advisories was given.  */
+  int delta_given ;	/* Whether delta was given.  */
+  int coalesce_given ;	/* Whether coalesce was given.  */
+  int cache_given ;	/* Whether cache was given.  */
+  int control_given ;	/* Whether control was given.  */
 
 } ;
 